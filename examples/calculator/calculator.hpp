@@ -8,6 +8,7 @@
 
 #include <fn/and_then.hpp>
 #include <fn/expected.hpp>
+#include <fn/fold_until.hpp>
 #include <fn/pack.hpp>
 #include <fn/transform.hpp>
 #include <fn/utility.hpp>
@@ -15,8 +16,8 @@
 #include <cerrno>
 #include <cmath>
 #include <cstdlib>
-#include <iterator>
 #include <limits>
+#include <ranges>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -209,8 +210,10 @@ constexpr inline auto execute = fn::overload{
     [](Push p) -> Results { return p.value.apply([](auto v) -> Results { return {fn::pack<decltype(v)>{v}}; }); }};
 
 // One token = one step: look the operation up, pop as many operands as it declares (folding them and
-// the operation itself into one cartesian copack of packs), execute the matching arm, store what it returns
-inline auto step(Stack s, std::string const &token) -> Result
+// the operation itself into one cartesian copack of packs), execute the matching arm, store what it returns.
+// Each named stage goes through `stage(name, step)`, which `step` passes through as it is; a profiler
+// wraps it instead - "operation" runs "execute" and "store" within it
+template <typename Stage> auto staged_step(Stage const &stage, Stack s, std::string const &token) -> Result
 {
   auto const store = [&s](auto &&...args) -> fn::expected<Stack, MathError> {
     static_assert(sizeof...(args) < 3);
@@ -219,42 +222,41 @@ inline auto step(Stack s, std::string const &token) -> Result
   };
 
   return (fn::expected<void, fn::copack<>>{} & lookup(token)) //
-         | fn::and_then([&s, &store](auto op) -> Result {
-             // the operation itself cannot fail — copack<> is the empty set of errors
-             using loaded = fn::expected<decltype(op), fn::copack<>>;
-             constexpr int take = decltype(op)::argument_count;
-             if constexpr (take == 0)
-               return execute(op) | fn::and_then(store);
-             else if constexpr (take == 1)
-               return (fn::expected<void, fn::copack<>>{} & pop(s) & loaded{op}) //
-                      | fn::and_then(execute)                                    //
-                      | fn::and_then(store);
-             else {
-               static_assert(decltype(op)::argument_count == 2);
-               auto rhs = pop(s); // popped before lhs: in `2 1 -` the top of the stack, 1, is the right operand
-               auto lhs = pop(s);
-               return (fn::expected<void, fn::copack<>>{} & std::move(lhs) & std::move(rhs) & loaded{op}) //
-                      | fn::and_then(execute)                                                             //
-                      | fn::and_then(store);
-             }
-           });
+         | stage("operation", fn::and_then([&s, &store, &stage](auto op) -> Result {
+                   // the operation itself cannot fail — copack<> is the empty set of errors
+                   using loaded = fn::expected<decltype(op), fn::copack<>>;
+                   constexpr int take = decltype(op)::argument_count;
+                   if constexpr (take == 0)
+                     return execute(op) | stage("store", fn::and_then(store));
+                   else if constexpr (take == 1)
+                     return (fn::expected<void, fn::copack<>>{} & pop(s) & loaded{op}) //
+                            | stage("execute", fn::and_then(execute))                 //
+                            | stage("store", fn::and_then(store));
+                   else {
+                     static_assert(decltype(op)::argument_count == 2);
+                     auto rhs = pop(s); // popped before lhs: in `2 1 -` the top of the stack, 1, is the right operand
+                     auto lhs = pop(s);
+                     return (fn::expected<void, fn::copack<>>{} & std::move(lhs) & std::move(rhs) & loaded{op}) //
+                            | stage("execute", fn::and_then(execute))                                          //
+                            | stage("store", fn::and_then(store));
+                   }
+                 }));
 }
 
-// Evaluate one line of whitespace-separated tokens — a recursive monadic fold over the stack
-// (Y-combinator: self is passed explicitly), where the first error short-circuits the rest of the line
-inline auto evaluate(Stack s, std::string_view line) -> Result
+inline auto step(Stack s, std::string const &token) -> Result
 {
-  using iterator = std::vector<std::string>::const_iterator;
-  static constexpr auto fold = [](auto self, Stack acc, iterator it, iterator end) -> Result {
-    if (it == end)
-      return {std::move(acc)};
-    return step(std::move(acc), *it) //
-           | fn::and_then([self, it, end](Stack next) { return self(self, std::move(next), std::next(it), end); });
+  constexpr auto as_is = [](std::string_view, auto &&stage) -> decltype(auto) {
+    return std::forward<decltype(stage)>(stage);
   };
+  return staged_step(as_is, std::move(s), token);
+}
 
+// Evaluate one line of whitespace-separated tokens — a monadic fold over the stack, where the first error
+// short-circuits the rest of the line; a loop, so a long line costs no stack depth
+inline auto evaluate(Stack s, std::string_view line) -> Result
+{
   std::istringstream stream{std::string{line}};
-  std::vector<std::string> const tokens{std::istream_iterator<std::string>{stream}, {}};
-  return fold(fold, std::move(s), tokens.begin(), tokens.end());
+  return fn::fold_until(std::views::istream<std::string>(stream), std::move(s), step);
 }
 
 } // namespace calc
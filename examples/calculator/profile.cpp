@@ -0,0 +1,109 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+// Runs calc::step over a large input and prints the latency percentiles of each of its pipeline stages,
+// measured with fn::timed. The input is read from the file named on the command line, one line of
+// tokens per line, or else generated: a mix of numbers, arithmetic and stack operations, with the
+// occasional error.
+
+#include "calculator.hpp"
+
+#include <fn/timed.hpp>
+
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// calc::step, with every stage wrapped in fn::timed
+auto timed_step(calc::Stack s, std::string const &token) -> calc::Result
+{
+  constexpr auto timed = [](std::string_view label, auto &&stage) {
+    return fn::timed(label, std::forward<decltype(stage)>(stage));
+  };
+  return calc::staged_step(timed, std::move(s), token);
+}
+
+// The stages as calc::staged_step nests them: the time of each includes that of the stages within
+struct Stage final {
+  std::string_view label;
+  int depth;
+};
+constexpr Stage stages[] = {{"operation", 0}, {"execute", 1}, {"store", 1}};
+
+auto generate(std::size_t count) -> std::vector<std::string>
+{
+  static constexpr char const *operations[] = {"+", "-", "*", "/", "%", "dup", "swap", "drop", "x"};
+  std::vector<std::string> lines;
+  std::uint32_t state = 12345;
+  auto const next = [&state] {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+  };
+  for (std::size_t i = 0; i < count; ++i) {
+    std::string line = std::to_string(next() % 1000) + " " + std::to_string(next() % 100 + 1);
+    for (int j = 0; j < 6; ++j) {
+      line += ' ';
+      line += next() % 2 == 0 ? std::to_string(next() % 100) + (next() % 4 == 0 ? ".5" : "")
+                              : operations[next() % std::size(operations)];
+    }
+    lines.push_back(std::move(line));
+  }
+  return lines;
+}
+
+} // namespace
+
+auto main(int argc, char **argv) -> int
+try {
+  std::vector<std::string> lines;
+  if (argc > 1) {
+    std::ifstream file{argv[1]};
+    if (not file) {
+      std::cerr << "cannot open " << argv[1] << '\n';
+      return 1;
+    }
+    for (std::string line; std::getline(file, line);)
+      lines.push_back(std::move(line));
+  } else {
+    lines = generate(100'000);
+  }
+
+  std::size_t errors = 0;
+  for (auto const &line : lines) {
+    std::istringstream stream{line};
+    auto const r = fn::fold_until(std::views::istream<std::string>(stream), calc::Stack{}, timed_step);
+    errors += r.has_value() ? 0 : 1;
+  }
+
+  std::cout << lines.size() << " lines, " << errors << " with an error\n\n";
+  std::cout << std::left << std::setw(12) << "stage" << std::right << std::setw(10) << "count" << std::setw(10)
+            << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99" << std::setw(10) << "p99.9"
+            << "  (ns)\n";
+  auto const histograms = fn::timed_histograms();
+  for (auto const &[label, depth] : stages) {
+    auto const found = histograms.find(label);
+    if (found == histograms.end())
+      continue;
+    auto const &histogram = found->second;
+    std::cout << std::left << std::setw(12) << (std::string(2 * depth, ' ') + std::string(label)) << std::right
+              << std::setw(10) << histogram.count();
+    for (double const q : {0.5, 0.9, 0.99, 0.999})
+      std::cout << std::setw(10) << histogram.percentile(q);
+    std::cout << '\n';
+  }
+  return 0;
+} catch (std::exception const &e) {
+  std::cerr << e.what() << '\n';
+  return 1;
+}
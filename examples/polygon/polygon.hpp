@@ -7,7 +7,10 @@
 #define EXAMPLES_POLYGON_POLYGON
 
 #include <fn/and_then.hpp>
+#include <fn/boxed.hpp>
 #include <fn/expected.hpp>
+#include <fn/fold_until.hpp>
+#include <fn/transform.hpp>
 
 #include <array>
 #include <concepts>
@@ -59,7 +62,8 @@ struct parameters {
     static constexpr int code = 6;
   };
 
-  using error = fn::copack_for<non_ascii_characters, too_few_characters, too_few_parameters>;
+  // The usage message is boxed, so that the other errors, and the value, need not make room for it
+  using error = fn::copack_for<fn::boxed<too_few_parameters>, non_ascii_characters, too_few_characters>;
 
   using arguments_t = std::vector<std::string_view>;
 
@@ -69,7 +73,7 @@ struct parameters {
       std::string_view const program_name = (args.size() >= 1 && !args[0].empty()) //
                                                 ? args[0]
                                                 : std::string_view{"<program>"};
-      return ::fn::unexpected(too_few_parameters{program_name});
+      return ::fn::unexpected(fn::boxed{too_few_parameters{program_name}});
     }
 
     parameters params;
@@ -93,7 +97,8 @@ struct parameters {
 };
 
 template <typename T>
-concept parameters_error = parameters::error::has_type<std::remove_cvref_t<T>>;
+concept parameters_error = parameters::error::has_type<std::remove_cvref_t<T>>
+                           || parameters::error::has_type<fn::boxed<std::remove_cvref_t<T>>>;
 
 inline void print_error(parameters_error auto &&err) { std::cerr << FWD(err).message << "\n"; }
 
@@ -147,7 +152,8 @@ inline void print_error(file_path_error auto &&err)
 }
 
 struct inputs {
-  using error = fn::copack_for<file_not_found, io_error, permission_denied>;
+  // Boxed, so that opening a file returns an expected as small as a pointer and its discriminant
+  using error = fn::copack_for<fn::boxed<file_not_found>, fn::boxed<io_error>, fn::boxed<permission_denied>>;
 
   struct stream {
     std::filesystem::path path; // "<stdin>" when source is std::cin
@@ -188,13 +194,13 @@ struct inputs {
           ec == std::errc::no_such_file_or_directory //
           || ec == std::errc::not_a_directory        //
           || type == std::filesystem::file_type::not_found) {
-        return ::fn::unexpected(file_not_found{{.path = std::move(path), .ec = ec}});
+        return ::fn::unexpected(fn::boxed{file_not_found{{.path = std::move(path), .ec = ec}}});
       }
       if (ec == std::errc::permission_denied) {
-        return ::fn::unexpected(permission_denied{{.path = std::move(path), .ec = ec}});
+        return ::fn::unexpected(fn::boxed{permission_denied{{.path = std::move(path), .ec = ec}}});
       }
-      return ::fn::unexpected(
-          io_error{{.path = std::move(path), .ec = (ec ? ec : std::make_error_code(std::io_errc::stream))}});
+      return ::fn::unexpected(fn::boxed{
+          io_error{{.path = std::move(path), .ec = (ec ? ec : std::make_error_code(std::io_errc::stream))}}});
     };
 
     static constexpr auto append = [](inputs r, std::filesystem::path path, std::unique_ptr<std::ifstream> f) {
@@ -203,21 +209,15 @@ struct inputs {
       return r;
     };
 
-    // Recursive monadic fold over the file list (Y-combinator: self is passed explicitly)
-    using iterator = std::vector<std::string>::const_iterator;
-    static constexpr auto fold = [](auto self, inputs r, iterator it, iterator end) -> fn::expected<inputs, error> {
-      if (it == end) {
-        return r;
-      }
-
-      return open_file(*it)  //
-             | fn::and_then( //
-                 [r = std::move(r), self, it, end](std::unique_ptr<std::ifstream> f) mutable {
-                   return self(self, append(std::move(r), *it, std::move(f)), std::next(it), end);
-                 });
+    // Monadic fold over the file list, stopping at the first file which fails to open
+    static constexpr auto open_next = [](inputs r, std::string const &filename) -> fn::expected<inputs, error> {
+      return open_file(filename) //
+             | fn::transform([&r, &filename](std::unique_ptr<std::ifstream> f) {
+                 return append(std::move(r), filename, std::move(f));
+               });
     };
 
-    return fold(fold, std::move(init), p.files.begin(), p.files.end());
+    return fn::fold_until(p.files, std::move(init), open_next);
   }
 };
 
@@ -180,21 +180,21 @@ TEST_CASE("parameters::make zero parameters", "[polygon][parameters]")
 {
   auto const result = parameters::make({});
   REQUIRE(not result.has_value());
-  CHECK(result.error() == parameters::error{parameters::too_few_parameters{"<program>"}});
+  CHECK(result.error() == parameters::error{fn::boxed{parameters::too_few_parameters{"<program>"}}});
 }
 
 TEST_CASE("parameters::make empty program name", "[polygon][parameters]")
 {
   auto const result = parameters::make({""});
   REQUIRE(not result.has_value());
-  CHECK(result.error() == parameters::error{parameters::too_few_parameters{"<program>"}});
+  CHECK(result.error() == parameters::error{fn::boxed{parameters::too_few_parameters{"<program>"}}});
 }
 
 TEST_CASE("parameters::make too few parameters", "[polygon][parameters]")
 {
   auto const result = parameters::make({"polygon"});
   REQUIRE(not result.has_value());
-  CHECK(result.error() == parameters::error{parameters::too_few_parameters{"polygon"}});
+  CHECK(result.error() == parameters::error{fn::boxed{parameters::too_few_parameters{"polygon"}}});
 }
 
 TEST_CASE("parameters::make rejects an invalid characters argument", "[polygon][parameters]")
@@ -234,8 +234,8 @@ TEST_CASE("inputs::make", "[polygon][inputs]")
     parameters const p{.characters = "abc", .required = static_cast<unsigned char>('a'), .files = {missing.string()}};
     auto const result = inputs::make(p);
     REQUIRE(not result.has_value());
-    REQUIRE(result.error().has_value<file_not_found>());
-    auto const &err = *result.error().get_ptr<file_not_found>();
+    REQUIRE(result.error().has_value<fn::boxed<file_not_found>>());
+    auto const &err = **result.error().get_ptr<fn::boxed<file_not_found>>();
     CHECK(err.path == missing);
     CHECK(err.ec == std::errc::no_such_file_or_directory);
   }
@@ -247,8 +247,8 @@ TEST_CASE("inputs::make", "[polygon][inputs]")
     parameters const p{.characters = "abc", .required = static_cast<unsigned char>('a'), .files = {subpath.string()}};
     auto const result = inputs::make(p);
     REQUIRE(not result.has_value());
-    REQUIRE(result.error().has_value<file_not_found>());
-    auto const &err = *result.error().get_ptr<file_not_found>();
+    REQUIRE(result.error().has_value<fn::boxed<file_not_found>>());
+    auto const &err = **result.error().get_ptr<fn::boxed<file_not_found>>();
     CHECK(err.path == subpath);
     // A non-directory path component is ENOTDIR on POSIX but ERROR_PATH_NOT_FOUND on Windows, which
     // maps to no_such_file_or_directory; either way make() routes it to file_not_found above.
@@ -277,8 +277,8 @@ TEST_CASE("inputs::make", "[polygon][inputs]")
     parameters const p{.characters = "abc", .required = static_cast<unsigned char>('a'), .files = {a.string()}};
     auto const result = inputs::make(p);
     REQUIRE(not result.has_value());
-    REQUIRE(result.error().has_value<io_error>());
-    auto const &err = *result.error().get_ptr<io_error>();
+    REQUIRE(result.error().has_value<fn::boxed<io_error>>());
+    auto const &err = **result.error().get_ptr<fn::boxed<io_error>>();
     CHECK(err.path == a);
     CHECK(err.ec);
   }
@@ -0,0 +1,331 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_ASYNC
+#define INCLUDE_FN_ASYNC
+
+#include <fn/expected.hpp>
+#include <fn/functor.hpp>
+#include <fn/monadic.hpp>
+#include <fn/optional.hpp>
+#include <fn/thread_pool.hpp>
+#include <libfn_version.hpp>
+
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+template <typename V> class async;
+
+namespace detail {
+template <typename T> constexpr bool _is_some_async = false;
+template <typename V> constexpr bool _is_some_async<::fn::async<V> &> = true;
+template <typename V> constexpr bool _is_some_async<::fn::async<V> const &> = true;
+
+// An executor, by reference and with its type erased, so that stages of one pipeline share a type
+class _executor_ref final {
+  void *self_;
+  void (*execute_)(void *, _task &&);
+
+public:
+  template <executor E>
+    requires(not ::std::same_as<E, _executor_ref>)
+  explicit _executor_ref(E &e) noexcept
+      : self_(::std::addressof(e)),
+        execute_([](void *self, _task &&t) { static_cast<E *>(self)->execute(::std::move(t)); })
+  {
+  }
+
+  void execute(_task &&t) const { execute_(self_, ::std::move(t)); }
+};
+
+// The outcome of one stage - a carrier or the exception which escaped - and the stage to run next
+template <typename V> class _async_state final {
+  ::std::mutex mutex_;
+  ::std::condition_variable done_cv_;
+  ::std::optional<V> value_;
+  ::std::exception_ptr exception_;
+  _task next_;
+  ::std::optional<_executor_ref> next_executor_;
+  bool done_ = false;
+
+public:
+  // The outcome is written before done_ is set under the lock, and read only after done_ is seen
+  // under the same lock, so the mutex orders both. An executor refusing the next stage - by throwing
+  // from `execute` - leaves it to run here, on the thread which finished this one.
+  template <typename F> void fulfil(F &&make) noexcept
+  {
+    try {
+      value_.emplace(FWD(make)());
+    } catch (...) {
+      exception_ = ::std::current_exception();
+    }
+    _task next;
+    ::std::optional<_executor_ref> executor;
+    {
+      ::std::lock_guard const lock{mutex_};
+      done_ = true;
+      next = ::std::move(next_);
+      executor = next_executor_;
+    }
+    done_cv_.notify_all();
+    if (not next)
+      return;
+    try {
+      executor->execute(::std::move(next));
+      return;
+    } catch (...) {
+    }
+    if (next)
+      next();
+  }
+
+  // Schedules the stage on the executor once the outcome is ready
+  void then(_executor_ref executor, _task &&t)
+  {
+    {
+      ::std::lock_guard const lock{mutex_};
+      if (not done_) {
+        next_ = ::std::move(t);
+        next_executor_.emplace(executor);
+        return;
+      }
+    }
+    executor.execute(::std::move(t));
+  }
+
+  [[nodiscard]] auto ready() noexcept -> bool
+  {
+    ::std::lock_guard const lock{mutex_};
+    return done_;
+  }
+
+  void wait()
+  {
+    ::std::unique_lock lock{mutex_};
+    done_cv_.wait(lock, [this] { return done_; });
+  }
+
+  [[nodiscard]] auto take() -> V
+  {
+    wait();
+    if (exception_)
+      ::std::rethrow_exception(exception_);
+    return *::std::move(value_);
+  }
+};
+
+// The internals of `async` one specialization needs of another, and `launch` of all of them
+struct _async_access final {
+  template <typename V> static auto make(_executor_ref executor) -> ::fn::async<V> { return ::fn::async<V>{executor}; }
+  template <typename V> static auto state(::fn::async<V> const &a) noexcept -> auto const & { return a.state_; }
+  template <typename V> static auto release(::fn::async<V> &a) noexcept { return ::std::move(a.state_); }
+};
+} // namespace detail
+
+/**
+ * @brief Checks if the type is an `fn::async`
+ *
+ * @tparam T The type to check, cv-ref qualified as deduced
+ */
+template <typename T>
+concept some_async = detail::_is_some_async<T &>;
+
+/**
+ * @brief A carrier which is not there yet, computed by pipeline stages running on an executor
+ *
+ * An `async` is fed into the same steps as the carrier it will hold - `and_then`, `transform`,
+ * `or_else`, `inspect`, a `fn::pipeline` - and `async | step` returns at once: the step is
+ * scheduled on the executor, to run on the carrier when it is ready, and yields the `async` of what
+ * `carrier | step` yields. Errors are therefore graded as they are without `async`, widening into
+ * the `copack_for` of the errors met. Combining two with `&` joins them, so that independent stages
+ * overlap, and the result waits for both. The calling thread never blocks, other than in `wait` or
+ * `get`.
+ *
+ * Each stage is a separate task, allocated on the heap together with its step; a step holds its
+ * arguments as any `functor` does, so a callable passed as an lvalue must outlive the pipeline. An
+ * exception escaping a stage skips the remaining ones and is thrown from `get`.
+ *
+ * @tparam V The carrier: `fn::expected` or `fn::optional`, without cv-ref qualifiers
+ */
+template <typename V> class async final {
+  static_assert(some_monadic_type<V> && ::std::same_as<V, ::std::remove_cvref_t<V>>);
+
+  friend struct detail::_async_access;
+
+  ::std::shared_ptr<detail::_async_state<V>> state_;
+  detail::_executor_ref executor_;
+
+  explicit async(detail::_executor_ref executor) : state_(::std::make_shared<detail::_async_state<V>>()),
+                                                   executor_(executor)
+  {
+  }
+
+public:
+  using value_type = V;
+
+  /**
+   * @brief An `async` ready at once, holding the carrier
+   *
+   * @param executor The executor running the stages which follow
+   * @param value The carrier
+   */
+  template <executor E>
+  async(E &executor, V value) : async(detail::_executor_ref{executor})
+  {
+    state_->fulfil([&value]() noexcept -> V && { return ::std::move(value); });
+  }
+
+  async(async &&) noexcept = default;
+  async &operator=(async &&) noexcept = default;
+  async(async const &) = delete;
+  async &operator=(async const &) = delete;
+
+  /**
+   * @brief Checks if this refers to a computation: false once moved from, or consumed
+   *
+   * Every other member, and each operator, requires `valid()`, as those of `std::future` do.
+   */
+  [[nodiscard]] auto valid() const noexcept -> bool { return state_ != nullptr; }
+
+  /**
+   * @brief Checks, without blocking, if the carrier is ready
+   *
+   * @pre `valid()`
+   */
+  [[nodiscard]] auto ready() const noexcept -> bool { return state_->ready(); }
+
+  /**
+   * @brief Blocks until the carrier is ready
+   *
+   * @pre `valid()`
+   */
+  void wait() const { state_->wait(); }
+
+  /**
+   * @brief Blocks until the carrier is ready and takes it
+   *
+   * @pre `valid()`
+   * @return The carrier, or throws the exception which escaped a stage
+   */
+  [[nodiscard]] auto get() && -> V
+  {
+    auto const state = ::std::move(state_);
+    return state->take();
+  }
+
+  /**
+   * @brief Schedules a pipeline step to run on the carrier, once it is ready
+   *
+   * @param lh The `async`, consumed
+   * @param rh The step, such as `fn::and_then(f)`, stored in the scheduled stage
+   * @return An `async` of what the step returns for the carrier
+   */
+  [[nodiscard]] friend auto operator|(async &&lh, some_functor auto &&rh)
+      -> async<::std::remove_cvref_t<decltype(::std::declval<V>() | FWD(rh))>>
+  {
+    using result_t = ::std::remove_cvref_t<decltype(::std::declval<V>() | FWD(rh))>;
+    using step_t = ::std::remove_cvref_t<decltype(rh)>;
+    auto ret = detail::_async_access::make<result_t>(lh.executor_);
+    auto const in = ::std::move(lh.state_);
+    in->then(lh.executor_,
+             detail::_task{[in, out = detail::_async_access::state(ret), step = step_t(FWD(rh))]() mutable {
+               out->fulfil([&]() -> result_t { return in->take() | ::std::move(step); });
+             }});
+    return ret;
+  }
+
+  /**
+   * @brief Joins two independent computations, which run in the meantime
+   *
+   * @param lh The `async` whose executor runs the stages which follow, consumed
+   * @param rh The other `async`, consumed
+   * @return An `async` of the two carriers combined with `&`
+   */
+  template <typename U>
+  [[nodiscard]] friend auto operator&(async &&lh, async<U> &&rh)
+      -> async<::std::remove_cvref_t<decltype(::std::declval<V>() & ::std::declval<U>())>>
+  {
+    using result_t = ::std::remove_cvref_t<decltype(::std::declval<V>() & ::std::declval<U>())>;
+    auto ret = detail::_async_access::make<result_t>(lh.executor_);
+    auto const left = ::std::move(lh.state_);
+    auto const right = detail::_async_access::release(rh);
+    // Whichever side is ready last combines them, on the executor which scheduled it
+    auto join = [left, right, out = detail::_async_access::state(ret),
+                 count = ::std::make_shared<::std::atomic<int>>(2)] {
+      if (count->fetch_sub(1, ::std::memory_order_acq_rel) != 1)
+        return;
+      out->fulfil([&]() -> result_t {
+        auto l = left->take();
+        auto r = right->take();
+        return ::std::move(l) & ::std::move(r);
+      });
+    };
+    left->then(lh.executor_, detail::_task{join});
+    right->then(lh.executor_, detail::_task{join});
+    return ret;
+  }
+};
+
+/**
+ * @brief Starts a computation on an executor, returning its `async`
+ *
+ * Use through the `fn::launch` nielbloid.
+ */
+constexpr inline struct launch_t final {
+  /**
+   * @brief Schedules the callable on the executor
+   *
+   * @param executor The executor, running this and every following stage
+   * @param fn A callable with no arguments, returning `fn::expected` or `fn::optional`
+   * @return The `async` of what the callable returns
+   */
+  template <executor E, typename F>
+    requires ::std::invocable<::std::decay_t<F> &>
+             && some_monadic_type<::std::remove_cvref_t<::std::invoke_result_t<::std::decay_t<F> &>>>
+  [[nodiscard]] auto operator()(E &executor, F &&fn) const
+      -> async<::std::remove_cvref_t<::std::invoke_result_t<::std::decay_t<F> &>>>
+  {
+    using result_t = ::std::remove_cvref_t<::std::invoke_result_t<::std::decay_t<F> &>>;
+    auto ret = detail::_async_access::make<result_t>(detail::_executor_ref{executor});
+    executor.execute(
+        detail::_task{[out = detail::_async_access::state(ret), fn = ::std::decay_t<F>(FWD(fn))]() mutable {
+          out->fulfil([&]() -> result_t { return ::std::invoke(fn); });
+        }});
+    return ret;
+  }
+
+  /**
+   * @brief Schedules the callable on the shared `fn::thread_pool`
+   *
+   * @param fn A callable with no arguments, returning `fn::expected` or `fn::optional`
+   * @return The `async` of what the callable returns
+   */
+  template <typename F>
+    requires ::std::invocable<::std::decay_t<F> &>
+             && some_monadic_type<::std::remove_cvref_t<::std::invoke_result_t<::std::decay_t<F> &>>>
+  [[nodiscard]] auto operator()(F &&fn) const
+  {
+    return (*this)(thread_pool::shared(), FWD(fn));
+  }
+} launch = {}; ///< Starts an async pipeline: `launch(executor, fn)` or `launch(fn)`
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_ASYNC
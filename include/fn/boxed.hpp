@@ -0,0 +1,186 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_BOXED
+#define INCLUDE_FN_BOXED
+
+#include <fn/detail/fwd.hpp>
+#include <libfn_version.hpp>
+
+#include <concepts>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+namespace detail {
+// Shared by every boxed type, and never destroyed: a boxed value may outlive other static objects
+inline auto _boxed_resource() -> ::std::pmr::memory_resource &
+{
+  static auto *const resource = new ::std::pmr::synchronized_pool_resource{};
+  return *resource;
+}
+} // namespace detail
+
+/**
+ * @brief A value stored out of line, for a large alternative of an error `copack`
+ *
+ * Holds a pointer to a `T` allocated from a pool shared by all boxed values, so it is as large as a
+ * pointer whatever the size of `T`: an `expected<V, copack_for<boxed<E>, ...>>` is not enlarged by
+ * `E`, which is paid for only when an error is made. Copying copies the value; moving moves the
+ * pointer, never throws, and leaves the source fit only to be assigned to or destroyed.
+ *
+ * Dispatch is transparent: `apply`, and every operation built on it, hands a boxed alternative
+ * over as the `T` it holds, with the value category of the box. A callable which takes only the box
+ * itself gets that very box: a box is not made from a value implicitly, so never a copy. The
+ * type-indexed operations, such as `has_value`, `get_ptr` and `apply_type`, name the alternative as
+ * stored, `boxed<T>`.
+ *
+ * In constant evaluation the value is allocated with `new` rather than from the pool.
+ *
+ * @tparam T The type of the value, a non-const object type
+ */
+template <typename T> class boxed final {
+  static_assert(::std::is_object_v<T> && not ::std::is_array_v<T> && not ::std::is_const_v<T>
+                && not ::std::is_volatile_v<T>);
+
+  T *ptr_;
+
+  template <typename... Args> [[nodiscard]] static constexpr auto _make(Args &&...args) -> T *
+  {
+    if (::std::is_constant_evaluated())
+      return new T(FWD(args)...);
+    auto &resource = detail::_boxed_resource();
+    void *const p = resource.allocate(sizeof(T), alignof(T));
+    try {
+      return ::std::construct_at(static_cast<T *>(p), FWD(args)...);
+    } catch (...) {
+      resource.deallocate(p, sizeof(T), alignof(T));
+      throw;
+    }
+  }
+
+  static constexpr void _drop(T *p) noexcept
+  {
+    if (p == nullptr)
+      return;
+    if (::std::is_constant_evaluated()) {
+      delete p;
+      return;
+    }
+    ::std::destroy_at(p);
+    detail::_boxed_resource().deallocate(p, sizeof(T), alignof(T));
+  }
+
+public:
+  using value_type = T;
+
+  /**
+   * @brief Constructs the value in place
+   *
+   * @param args The arguments of the constructor of `T`
+   */
+  template <typename... Args>
+    requires ::std::is_constructible_v<T, Args...>
+  constexpr explicit boxed(::std::in_place_t, Args &&...args) : ptr_(_make(FWD(args)...))
+  {
+  }
+
+  /**
+   * @brief Boxes a copy of the value
+   *
+   * @param v The value
+   */
+  explicit constexpr boxed(T const &v)
+    requires ::std::is_copy_constructible_v<T>
+      : ptr_(_make(v))
+  {
+  }
+
+  /**
+   * @brief Boxes the value, moved from
+   *
+   * @param v The value
+   */
+  explicit constexpr boxed(T &&v)
+    requires ::std::is_move_constructible_v<T>
+      : ptr_(_make(::std::move(v)))
+  {
+  }
+
+  constexpr boxed(boxed const &o)
+    requires ::std::is_copy_constructible_v<T>
+      : ptr_(o.ptr_ == nullptr ? nullptr : _make(*o.ptr_))
+  {
+  }
+
+  constexpr boxed(boxed &&o) noexcept : ptr_(::std::exchange(o.ptr_, nullptr)) {}
+
+  constexpr auto operator=(boxed const &o) -> boxed &
+    requires ::std::is_copy_constructible_v<T>
+  {
+    boxed tmp{o};
+    swap(tmp);
+    return *this;
+  }
+
+  constexpr auto operator=(boxed &&o) noexcept -> boxed &
+  {
+    _drop(::std::exchange(ptr_, ::std::exchange(o.ptr_, nullptr)));
+    return *this;
+  }
+
+  constexpr ~boxed() { _drop(ptr_); }
+
+  /**
+   * @brief Swaps the values, by their pointers
+   *
+   * @param o The other box
+   */
+  constexpr void swap(boxed &o) noexcept { ::std::swap(ptr_, o.ptr_); }
+  friend constexpr void swap(boxed &lh, boxed &rh) noexcept { lh.swap(rh); }
+
+  /**
+   * @brief The address of the value
+   */
+  [[nodiscard]] constexpr auto get() const noexcept -> T * { return ptr_; }
+
+  /**
+   * @brief The value, with the value category of the box
+   */
+  [[nodiscard]] constexpr auto operator*() & noexcept -> T & { return *ptr_; }
+  [[nodiscard]] constexpr auto operator*() const & noexcept -> T const & { return *ptr_; }
+  [[nodiscard]] constexpr auto operator*() && noexcept -> T && { return ::std::move(*ptr_); }
+  [[nodiscard]] constexpr auto operator*() const && noexcept -> T const && { return ::std::move(*ptr_); }
+
+  [[nodiscard]] constexpr auto operator->() noexcept -> T * { return ptr_; }
+  [[nodiscard]] constexpr auto operator->() const noexcept -> T const * { return ptr_; }
+
+  /**
+   * @brief Compares the values held; a box moved from holds none, and equals only another such box
+   */
+  [[nodiscard]] friend constexpr bool operator==(boxed const &lh, boxed const &rh) //
+      noexcept(noexcept(static_cast<bool>(*lh.ptr_ == *rh.ptr_)))
+    requires ::std::equality_comparable<T>
+  {
+    if (lh.ptr_ == nullptr || rh.ptr_ == nullptr)
+      return lh.ptr_ == rh.ptr_;
+    return *lh.ptr_ == *rh.ptr_;
+  }
+};
+
+template <typename T> boxed(T) -> boxed<T>;
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_BOXED
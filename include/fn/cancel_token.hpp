@@ -0,0 +1,71 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_CANCEL_TOKEN
+#define INCLUDE_FN_CANCEL_TOKEN
+
+#include <libfn_version.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+class cancel_token;
+
+namespace detail {
+// The one way to a token which can be cancelled; used by the algorithms handing tokens out
+struct _cancel_token_source final {
+  [[nodiscard]] static constexpr auto make(::std::atomic<::std::size_t> const &mark, ::std::size_t index) noexcept
+      -> cancel_token;
+};
+} // namespace detail
+
+/**
+ * @brief Tells a task of `par_conjoin` or `race` that its result can no longer matter
+ *
+ * A task which accepts the token can poll it, and return early - with any carrier of its type -
+ * once another task has decided the outcome. A default-constructed token is never cancelled.
+ */
+class cancel_token final {
+  friend struct detail::_cancel_token_source;
+
+  // Cancelled once the mark shared by all the tasks falls below this task's index
+  ::std::atomic<::std::size_t> const *mark_ = nullptr;
+  ::std::size_t index_ = 0;
+
+  constexpr cancel_token(::std::atomic<::std::size_t> const &mark, ::std::size_t index) noexcept
+      : mark_(::std::addressof(mark)), index_(index)
+  {
+  }
+
+public:
+  constexpr cancel_token() noexcept = default;
+
+  /**
+   * @brief Checks if the task should stop
+   */
+  [[nodiscard]] auto stop_requested() const noexcept -> bool
+  {
+    return mark_ != nullptr && mark_->load(::std::memory_order_acquire) < index_;
+  }
+};
+
+constexpr auto detail::_cancel_token_source::make(::std::atomic<::std::size_t> const &mark,
+                                                  ::std::size_t index) noexcept -> cancel_token
+{
+  return cancel_token{mark, index};
+}
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_CANCEL_TOKEN
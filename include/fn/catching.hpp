@@ -0,0 +1,215 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_CATCHING
+#define INCLUDE_FN_CATCHING
+
+#include <fn/copack.hpp>
+#include <fn/detail/meta.hpp>
+#include <fn/expected.hpp>
+#include <libfn_version.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+namespace detail {
+// The callable's result, in an expected over the caught exceptions: a returned expected keeps its
+// value and widens its error with them, anything else becomes the value
+template <typename R, typename Error> struct _catching_result {
+  using type = ::fn::expected<R, Error>;
+};
+template <typename T, typename E, typename Error> struct _catching_result<::fn::expected<T, E>, Error> {
+  using type = ::fn::expected<T, ::fn::copack_for<E, Error>>;
+};
+
+template <typename Ex>
+concept _catchable = ::std::is_class_v<Ex> && ::std::is_same_v<Ex, ::std::remove_cv_t<Ex>>
+                     && ::std::is_copy_constructible_v<Ex> && (not _some_copack<Ex>);
+
+template <typename... Exs> constexpr inline bool _catches_all = (... || ::std::is_same_v<Exs, ::std::exception_ptr>);
+} // namespace detail
+
+/**
+ * @brief A callable whose exceptions of the listed types are returned as errors
+ *
+ * Calls the wrapped callable with the arguments given and returns its result in an `expected`
+ * over `copack_for<Exs...>`, or, where the result is itself an `expected`, with its error widened
+ * by the same alternatives. An exception of one of `Exs` is caught by `const` reference and copied
+ * into the alternative of that type - so an exception derived from a listed type is sliced to it -
+ * the first listed type matching winning. Other exceptions propagate, unless `std::exception_ptr`
+ * is listed: it then catches everything else, holding `std::current_exception()`, and the call is
+ * `noexcept` wherever copying the caught exceptions into the error is.
+ *
+ * Made by the `fn::catching` nielbloid.
+ *
+ * @tparam Fn The wrapped callable
+ * @tparam Exs The exception types caught, and `std::exception_ptr` to catch all others
+ */
+template <typename Fn, typename... Exs> class catching_fn final {
+  static_assert(sizeof...(Exs) > 0);
+  static_assert((... && (detail::_catchable<Exs> || ::std::is_same_v<Exs, ::std::exception_ptr>)));
+
+  Fn fn_;
+
+  template <typename Self, typename... Args>
+  using _result_t = typename detail::_catching_result<::std::remove_cvref_t<::std::invoke_result_t<Self, Args...>>,
+                                                      ::fn::copack_for<Exs...>>::type;
+
+  // Every exception type listed, each with its own handler
+  template <typename Ret> static constexpr bool _nothrow_handlers //
+      = (... && (::std::is_same_v<Exs, ::std::exception_ptr>
+                 || ::std::is_nothrow_constructible_v<Ret, ::fn::unexpect_t, ::std::in_place_type_t<Exs>, Exs const &>))
+        && ::std::is_nothrow_constructible_v<Ret, ::fn::unexpect_t, ::std::in_place_type_t<::std::exception_ptr>,
+                                             ::std::exception_ptr>;
+
+  template <typename Ret, typename Self, typename... Args> static constexpr bool _nothrow_call = [] {
+    if constexpr (detail::_catches_all<Exs...>)
+      return _nothrow_handlers<Ret>;
+    else if constexpr (::std::is_void_v<::std::invoke_result_t<Self, Args...>>)
+      return ::std::is_nothrow_invocable_v<Self, Args...> && ::std::is_nothrow_default_constructible_v<Ret>;
+    else
+      return ::std::is_nothrow_invocable_v<Self, Args...>
+             && ::std::is_nothrow_constructible_v<Ret, ::std::invoke_result_t<Self, Args...>>;
+  }();
+
+  template <typename Ret, typename Self, typename... Args>
+  static constexpr auto _result(Self &&fn, Args &&...args) -> Ret
+  {
+    using type = ::std::invoke_result_t<Self, Args...>;
+    if constexpr (::std::is_void_v<type>) {
+      ::std::invoke(FWD(fn), FWD(args)...);
+      return Ret();
+    } else
+      return Ret(::std::invoke(FWD(fn), FWD(args)...));
+  }
+
+  // Nested so that the first of Exs is tried innermost, and wins over the others
+  template <typename Ret, ::std::size_t K, typename Self, typename... Args>
+  static constexpr auto _catch_upto(Self &&fn, Args &&...args) -> Ret
+  {
+    if constexpr (K == 0)
+      return _result<Ret>(FWD(fn), FWD(args)...);
+    else {
+      using ex_t = detail::select_nth_t<K - 1, Exs...>;
+      if constexpr (::std::is_same_v<ex_t, ::std::exception_ptr>)
+        return _catch_upto<Ret, K - 1>(FWD(fn), FWD(args)...);
+      else {
+        try {
+          return _catch_upto<Ret, K - 1>(FWD(fn), FWD(args)...);
+        } catch (ex_t const &e) {
+          return Ret(::fn::unexpect, ::std::in_place_type<ex_t>, e);
+        }
+      }
+    }
+  }
+
+  template <typename Ret, typename Self, typename... Args>
+  static constexpr auto _call(Self &&fn, Args &&...args) noexcept(_nothrow_call<Ret, Self, Args...>) -> Ret
+  {
+    if constexpr (detail::_catches_all<Exs...>) {
+      try {
+        return _catch_upto<Ret, sizeof...(Exs)>(FWD(fn), FWD(args)...);
+      } catch (...) {
+        return Ret(::fn::unexpect, ::std::in_place_type<::std::exception_ptr>, ::std::current_exception());
+      }
+    } else
+      return _catch_upto<Ret, sizeof...(Exs)>(FWD(fn), FWD(args)...);
+  }
+
+public:
+  /**
+   * @brief Wraps the callable
+   *
+   * @param fn The callable
+   */
+  template <typename F>
+    requires ::std::is_constructible_v<Fn, F>
+  constexpr explicit catching_fn(F &&fn) noexcept(::std::is_nothrow_constructible_v<Fn, F>) : fn_(FWD(fn))
+  {
+  }
+
+  /**
+   * @brief Calls the wrapped callable, returning the exceptions caught as errors
+   *
+   * @param args The arguments of the callable
+   * @return The callable's result in an `expected`, or the exception caught
+   */
+  template <typename... Args>
+    requires ::std::is_invocable_v<Fn &, Args...>
+  constexpr auto operator()(Args &&...args) & noexcept(_nothrow_call<_result_t<Fn &, Args...>, Fn &, Args...>)
+      -> _result_t<Fn &, Args...>
+  {
+    return _call<_result_t<Fn &, Args...>>(fn_, FWD(args)...);
+  }
+
+  template <typename... Args>
+    requires ::std::is_invocable_v<Fn const &, Args...>
+  constexpr auto operator()(Args &&...args) const & //
+      noexcept(_nothrow_call<_result_t<Fn const &, Args...>, Fn const &, Args...>) -> _result_t<Fn const &, Args...>
+  {
+    return _call<_result_t<Fn const &, Args...>>(fn_, FWD(args)...);
+  }
+
+  template <typename... Args>
+    requires ::std::is_invocable_v<Fn &&, Args...>
+  constexpr auto operator()(Args &&...args) && noexcept(_nothrow_call<_result_t<Fn &&, Args...>, Fn &&, Args...>)
+      -> _result_t<Fn &&, Args...>
+  {
+    return _call<_result_t<Fn &&, Args...>>(::std::move(fn_), FWD(args)...);
+  }
+
+  template <typename... Args>
+    requires ::std::is_invocable_v<Fn const &&, Args...>
+  constexpr auto operator()(Args &&...args) const && //
+      noexcept(_nothrow_call<_result_t<Fn const &&, Args...>, Fn const &&, Args...>) -> _result_t<Fn const &&, Args...>
+  {
+    return _call<_result_t<Fn const &&, Args...>>(::std::move(fn_), FWD(args)...);
+  }
+};
+
+/**
+ * @brief Wraps a callable so that the exceptions of the listed types are returned as errors
+ *
+ * Use through the `fn::catching` nielbloid.
+ *
+ * @tparam Exs The exception types caught, and `std::exception_ptr` to catch all others
+ */
+template <typename... Exs> struct catching_t final {
+  /**
+   * @brief Wraps the callable
+   *
+   * @param fn The callable, which may throw
+   * @return The `catching_fn` wrapping a copy of the callable
+   */
+  template <typename Fn>
+    requires ::std::is_constructible_v<::std::decay_t<Fn>, Fn>
+  [[nodiscard]] constexpr auto operator()(Fn &&fn) const
+      noexcept(::std::is_nothrow_constructible_v<::std::decay_t<Fn>, Fn>) -> catching_fn<::std::decay_t<Fn>, Exs...>
+  {
+    return catching_fn<::std::decay_t<Fn>, Exs...>(FWD(fn));
+  }
+};
+
+/**
+ * @brief Wraps a throwing callable at the boundary of a pipeline: `catching<Exs...>(fn)`
+ *
+ * @tparam Exs The exception types caught, and `std::exception_ptr` to catch all others
+ */
+template <typename... Exs> constexpr inline catching_t<Exs...> catching = {};
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_CATCHING
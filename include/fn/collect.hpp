@@ -0,0 +1,284 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_COLLECT
+#define INCLUDE_FN_COLLECT
+
+#include <fn/choice.hpp>
+#include <fn/copack.hpp>
+#include <fn/expected.hpp>
+#include <fn/just.hpp>
+#include <fn/optional.hpp>
+#include <libfn_version.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+namespace detail {
+// The element's carrier, rebound to hold the container: an expected keeps its error type, an
+// optional only the empty state, and a choice - which cannot fail - becomes a just. A void expected
+// has no values to collect and no type here.
+template <typename Container, typename Res> struct _collect_result {};
+template <typename Container, typename T, typename E>
+  requires(not ::std::is_void_v<T>)
+struct _collect_result<Container, ::fn::expected<T, E>> {
+  using type = ::fn::expected<Container, E>;
+};
+template <typename Container, typename T> struct _collect_result<Container, ::fn::optional<T>> {
+  using type = ::fn::optional<Container>;
+};
+template <typename Container, typename... Ts> struct _collect_result<Container, ::fn::choice<Ts...>> {
+  using type = ::fn::just<Container>;
+};
+
+// Only an expected has errors worth keeping, each widened into the copack of its error type
+template <typename Container, typename Res> struct _collect_all_result {};
+template <typename Container, typename T, typename E>
+  requires(not ::std::is_void_v<T>)
+struct _collect_all_result<Container, ::fn::expected<T, E>> {
+  using type = ::fn::expected<Container, ::std::vector<::fn::copack_for<E>>>;
+};
+
+// The elements of a range passed as an rvalue and owning them are moved from; those of an lvalue
+// or of a view, which may refer to elements owned elsewhere, are not
+template <typename R>
+using _collect_reference_t
+    = ::std::conditional_t<(not ::std::is_lvalue_reference_v<R>) && (not ::std::ranges::view<::std::remove_cvref_t<R>>),
+                           ::std::ranges::range_rvalue_reference_t<R>, ::std::ranges::range_reference_t<R>>;
+
+template <typename R> using _collect_element_t = ::std::remove_cvref_t<::std::ranges::range_reference_t<R>>;
+
+template <typename R, typename Container>
+using _collect_result_t = typename _collect_result<Container, _collect_element_t<R>>::type;
+
+template <typename R, typename Container>
+using _collect_all_result_t = typename _collect_all_result<Container, _collect_element_t<R>>::type;
+
+// The value of a present element; a choice always holds one, as its copack
+template <typename Res> [[nodiscard]] constexpr auto _collected(Res &&res) noexcept -> decltype(auto)
+{
+  if constexpr (_some_choice<Res>)
+    return FWD(res).value();
+  else
+    return *FWD(res);
+}
+
+template <typename R> using _collected_t = decltype(_collected(::std::declval<_collect_reference_t<R>>()));
+
+// Sequence containers are appended to, the others inserted into. Neither member is constrained on
+// its arguments, so the element type is asked directly.
+template <typename Container, typename V>
+concept _collect_back = requires(Container &c, V &&v) { c.emplace_back(FWD(v)); };
+
+template <typename Container, typename V>
+concept _collect_into = ::std::is_constructible_v<typename Container::value_type, V>
+                        && (_collect_back<Container, V> || requires(Container &c, V &&v) { c.emplace(FWD(v)); });
+
+template <typename Container, typename V> constexpr inline bool _nothrow_collect_one = false;
+template <typename Container, typename V>
+  requires _collect_back<Container, V>
+constexpr inline bool _nothrow_collect_one<Container, V>
+    = noexcept(::std::declval<Container &>().emplace_back(::std::declval<V>()));
+template <typename Container, typename V>
+  requires(not _collect_back<Container, V>) && _collect_into<Container, V>
+constexpr inline bool _nothrow_collect_one<Container, V>
+    = noexcept(::std::declval<Container &>().emplace(::std::declval<V>()));
+
+template <typename Container, typename V>
+constexpr void _collect_one(Container &c, V &&v) noexcept(_nothrow_collect_one<Container, V>)
+{
+  if constexpr (_collect_back<Container, V>)
+    c.emplace_back(FWD(v));
+  else
+    c.emplace(FWD(v));
+}
+
+template <typename R, typename Container>
+concept _collect_reserve
+    = ::std::ranges::sized_range<R> && requires(Container &c, ::std::size_t n) { c.reserve(n); };
+
+template <typename R, typename Container> [[nodiscard]] constexpr auto _collect_init(R &range) -> Container
+{
+  Container ret{};
+  if constexpr (_collect_reserve<R, Container>)
+    ret.reserve(static_cast<::std::size_t>(::std::ranges::size(range)));
+  return ret;
+}
+
+template <typename R, typename Container>
+constexpr inline bool _nothrow_collect_init = ::std::is_nothrow_default_constructible_v<Container>;
+template <typename R, typename Container>
+  requires _collect_reserve<R, Container>
+constexpr inline bool _nothrow_collect_init<R, Container>
+    = ::std::is_nothrow_default_constructible_v<Container> && noexcept(::std::ranges::size(::std::declval<R &>()))
+      && noexcept(::std::declval<Container &>().reserve(::std::size_t{}));
+
+template <typename R>
+constexpr inline bool _nothrow_collect_range
+    = noexcept(::std::ranges::begin(::std::declval<R &>())) && noexcept(::std::ranges::end(::std::declval<R &>()))
+      && noexcept(++::std::declval<::std::ranges::iterator_t<R> &>())
+      && noexcept(*::std::declval<::std::ranges::iterator_t<R> &>())
+      && noexcept(::std::declval<::std::ranges::iterator_t<R> &>() != ::std::declval<::std::ranges::sentinel_t<R> &>());
+
+// Passing the container on: a just holds it directly, the other carriers in place
+template <typename Ret, typename Container>
+constexpr inline bool _nothrow_collect_success
+    = ::std::is_nothrow_constructible_v<Ret, ::std::in_place_t, Container &&>;
+template <typename Ret, typename Container>
+  requires _some_just<Ret>
+constexpr inline bool _nothrow_collect_success<Ret, Container> = ::std::is_nothrow_constructible_v<Ret, Container &&>;
+
+// Passing the failure on: an error is moved across, an empty state has nothing to move
+template <typename R, typename Ret> constexpr inline bool _nothrow_collect_failure = true;
+template <typename R, typename Ret>
+  requires _some_expected<_collect_element_t<R>>
+constexpr inline bool _nothrow_collect_failure<R, Ret>
+    = ::std::is_nothrow_constructible_v<Ret, ::fn::unexpect_t,
+                                        decltype(::std::declval<_collect_reference_t<R>>().error())>;
+
+template <typename R, typename Container>
+constexpr inline bool _nothrow_collect
+    = _nothrow_collect_init<R, Container> && _nothrow_collect_range<R>
+      && _nothrow_collect_one<Container, _collected_t<R>>
+      && _nothrow_collect_success<_collect_result_t<R, Container>, Container>
+      && _nothrow_collect_failure<R, _collect_result_t<R, Container>>;
+} // namespace detail
+
+/**
+ * @brief Checks if `collect` can gather the values of the range into the container
+ *
+ * The elements must be `expected` with a non-void value, `optional` or `choice`, and their values
+ * must go into the container by `emplace_back` or, failing that, by `emplace`.
+ *
+ * @tparam R The range
+ * @tparam Container The container
+ */
+template <typename R, typename Container>
+concept collectable                                                                 //
+    = ::std::ranges::input_range<R> && ::std::is_default_constructible_v<Container> //
+      && ::std::is_move_constructible_v<Container>                                  //
+      && requires { typename detail::_collect_result_t<R, Container>; }             //
+      && detail::_collect_into<Container, detail::_collected_t<R>>;
+
+/**
+ * @brief Gathers the values of a range of carriers into one carrier of a container, stopping at the
+ * first failure
+ *
+ * The container reserves its capacity up front when the range is sized, and each value goes into
+ * it in turn: moved where the range is an rvalue owning its elements, copied otherwise. The first
+ * failure ends the loop, the remaining elements unvisited, and is returned in place of the
+ * container - the error of an `expected` as the element holds it, the empty state of an
+ * `optional`. A range of `choice` cannot fail, and its copacks are gathered into a `just`.
+ *
+ * Use through the `fn::collect` nielbloid.
+ *
+ * @tparam Container The container, such as `std::vector<T>`
+ */
+template <typename Container> struct collect_t final {
+  static_assert(::std::is_object_v<Container> && ::std::is_same_v<Container, ::std::remove_cv_t<Container>>);
+
+  /**
+   * @brief Gathers the values of the range, stopping at the first failure
+   *
+   * @param range The carriers, visited in order
+   * @return The container in the elements' carrier, or the first failure
+   */
+  template <::std::ranges::input_range R>
+    requires collectable<R, Container>
+  [[nodiscard]] constexpr auto operator()(R &&range) const noexcept(detail::_nothrow_collect<R, Container>)
+      -> detail::_collect_result_t<R, Container>
+  {
+    using result_t = detail::_collect_result_t<R, Container>;
+    using reference_t = detail::_collect_reference_t<R>;
+    Container ret = detail::_collect_init<R, Container>(range);
+    for (auto &&element : range) {
+      if constexpr (not some_choice<detail::_collect_element_t<R>>) {
+        if (not element.has_value()) {
+          if constexpr (some_expected<result_t>)
+            return result_t(::fn::unexpect, static_cast<reference_t>(element).error());
+          else
+            return result_t(::std::nullopt);
+        }
+      }
+      detail::_collect_one(ret, detail::_collected(static_cast<reference_t>(element)));
+    }
+    if constexpr (some_just<result_t>)
+      return result_t(::std::move(ret));
+    else
+      return result_t(::std::in_place, ::std::move(ret));
+  }
+};
+
+/**
+ * @brief Gathers the values of a range of `expected` into a container, or else all of their errors
+ *
+ * Where `collect` stops at the first failure, this visits every element: each error is widened
+ * into the `copack_for` of the error type and appended to a vector, which the result holds in
+ * place of the container when it is not empty. Once an error is seen, values are no longer added
+ * to the container, which is then discarded.
+ *
+ * Use through the `fn::collect_all` nielbloid.
+ *
+ * @tparam Container The container, such as `std::vector<T>`
+ */
+template <typename Container> struct collect_all_t final {
+  static_assert(::std::is_object_v<Container> && ::std::is_same_v<Container, ::std::remove_cv_t<Container>>);
+
+  /**
+   * @brief Gathers the values of the range, or all of its errors
+   *
+   * @param range The carriers, visited in order
+   * @return The container in an `expected`, or the vector of every error in the range
+   */
+  template <::std::ranges::input_range R>
+    requires collectable<R, Container> && requires { typename detail::_collect_all_result_t<R, Container>; }
+  [[nodiscard]] constexpr auto operator()(R &&range) const -> detail::_collect_all_result_t<R, Container>
+  {
+    using result_t = detail::_collect_all_result_t<R, Container>;
+    using reference_t = detail::_collect_reference_t<R>;
+    Container ret = detail::_collect_init<R, Container>(range);
+    typename result_t::error_type errors{};
+    for (auto &&element : range) {
+      if (not element.has_value())
+        errors.emplace_back(static_cast<reference_t>(element).error());
+      else if (errors.empty())
+        detail::_collect_one(ret, detail::_collected(static_cast<reference_t>(element)));
+    }
+    if (not errors.empty())
+      return result_t(::fn::unexpect, ::std::move(errors));
+    return result_t(::std::in_place, ::std::move(ret));
+  }
+};
+
+/**
+ * @brief Gathers a range of carriers into a container: `collect<std::vector<T>>(range)`
+ *
+ * @tparam Container The container
+ */
+template <typename Container> constexpr inline collect_t<Container> collect = {};
+
+/**
+ * @brief Gathers a range of `expected` into a container, or all of its errors:
+ * `collect_all<std::vector<T>>(range)`
+ *
+ * @tparam Container The container
+ */
+template <typename Container> constexpr inline collect_all_t<Container> collect_all = {};
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_COLLECT
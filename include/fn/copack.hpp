@@ -9,10 +9,15 @@
 #include <fn/detail/functional.hpp>
 #include <fn/detail/meta.hpp>
 #include <fn/detail/traits.hpp>
+#include <fn/detail/uses_allocator.hpp>
 #include <fn/detail/variadic_union.hpp>
 #include <fn/functional.hpp>
 #include <libfn_version.hpp>
 
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -60,6 +65,15 @@ static constexpr bool _is_valid_copack_subtype //
 
 struct _apply_autodetect_tag final {};
 
+// The discriminant of a copack: the narrowest unsigned type to count its alternatives, so that a
+// copack of small alternatives is neither widened nor word-aligned by its index - nor, in turn, is
+// an `expected` holding such a copack as its error.
+template <::std::size_t N>
+using _copack_index_t = ::std::conditional_t<
+    (N <= 0xff), ::std::uint8_t,
+    ::std::conditional_t<(N <= 0xffff), ::std::uint16_t,
+                         ::std::conditional_t<(N <= 0xffff'ffff), ::std::uint32_t, ::std::size_t>>>;
+
 // Whether comparing an alternative can throw. An alternative the other side does not have is never
 // compared, so it cannot throw - and need not even be comparable, which is why this is a guarded
 // specialization rather than a disjunction: unlike a requires-clause, a noexcept-specifier is an
@@ -308,9 +322,18 @@ struct copack<Ts...> {
    */
   data_t data;
   /**
-   * @brief The index of the active alternative
+   * @brief The type of the index, the narrowest unsigned type to count the alternatives
+   *
+   * This is `std::uint8_t` for up to 255 alternatives, not `std::size_t` as before: the index no
+   * longer widens and word-aligns a copack of small alternatives, nor an `expected` holding one. It
+   * converts implicitly to `std::size_t`, but arithmetic on it promotes to `int`, and a stream
+   * prints a `std::uint8_t` as a character; convert it first where either matters.
+   */
+  using index_t = detail::_copack_index_t<sizeof...(Ts)>;
+  /**
+   * @brief The index of the active alternative, of type `index_t` - see there
    */
-  ::std::size_t index;
+  index_t index;
 
   /**
    * @brief The number of alternatives
@@ -410,6 +433,41 @@ struct copack<Ts...> {
     return detail::invoke_type_variadic_union<type, data_t>(::std::move(*this).data, index, FWD(fn));
   }
 
+  // Where each alternative of a narrower copack lands in this one: widening looks its index up here,
+  // rather than dispatching on the source a second time only to name the alternative it holds.
+  template <typename... Tx>
+  static constexpr index_t _remap[sizeof...(Tx)] = {static_cast<index_t>(detail::type_index<Tx, Ts...>)...};
+
+  template <typename... Tx>
+  [[nodiscard]] static constexpr auto _widened_index(copack<Tx...> const &arg) noexcept -> index_t
+  {
+    return _remap<Tx...>[arg.index];
+  }
+
+  // Every alternative of a union lives at its start, so where both unions are trivially copyable the
+  // bytes of the narrower one are the wider one's with the same alternative active, and widening is
+  // a copy of the bytes. Not in constant evaluation, where the union cannot be reinterpreted.
+  template <typename C>
+  static constexpr bool _bitwise_widenable
+      = ::std::is_trivially_copyable_v<data_t> && ::std::is_trivially_copyable_v<typename C::data_t>;
+
+  template <typename C>
+  [[nodiscard]] static constexpr auto _widened_data(C &&arg) -> data_t
+  {
+    using source_t = typename ::std::remove_cvref_t<C>::data_t;
+    if constexpr (_bitwise_widenable<::std::remove_cvref_t<C>>) {
+      static_assert(sizeof(source_t) <= sizeof(data_t) && alignof(source_t) <= alignof(data_t));
+      if (not ::std::is_constant_evaluated()) {
+        unsigned char bytes[sizeof(data_t)] = {};
+        ::std::memcpy(bytes, &arg.data, sizeof(source_t));
+        return ::std::bit_cast<data_t>(bytes);
+      }
+    }
+    return FWD(arg).template _invoke<data_t>([]<typename T>(::std::in_place_type_t<T>, auto &&v) -> data_t {
+      return detail::make_variadic_union<T, data_t>(FWD(v));
+    });
+  }
+
   /**
    * @brief Constructs the alternative matching the value's decayed type
    *
@@ -425,7 +483,7 @@ struct copack<Ts...> {
     requires has_type<::std::remove_cvref_t<T>> && (detail::_makeable<data_t, ::std::remove_cvref_t<T>, decltype(v)>)
                  && (::std::is_convertible_v<decltype(v), ::std::remove_cvref_t<T>>)
       : data(detail::make_variadic_union<::std::remove_cvref_t<T>, data_t>(FWD(v))),
-        index(detail::type_index<::std::remove_cvref_t<T>, Ts...>)
+        index(static_cast<index_t>(detail::type_index<::std::remove_cvref_t<T>, Ts...>))
   {
   }
 
@@ -435,7 +493,7 @@ struct copack<Ts...> {
     requires has_type<::std::remove_cvref_t<T>> && (detail::_makeable<data_t, ::std::remove_cvref_t<T>, decltype(v)>)
                  && (not ::std::is_convertible_v<decltype(v), ::std::remove_cvref_t<T>>)
       : data(detail::make_variadic_union<::std::remove_cvref_t<T>, data_t>(FWD(v))),
-        index(detail::type_index<::std::remove_cvref_t<T>, Ts...>)
+        index(static_cast<index_t>(detail::type_index<::std::remove_cvref_t<T>, Ts...>))
   {
   }
 
@@ -449,7 +507,8 @@ struct copack<Ts...> {
   constexpr explicit copack(::std::in_place_type_t<T>,
                             auto &&...args) noexcept(detail::_nothrow_makeable<data_t, T, decltype(args)...>)
     requires has_type<T> && detail::_makeable<data_t, T, decltype(args)...>
-      : data(detail::make_variadic_union<T, data_t>(FWD(args)...)), index(detail::type_index<T, Ts...>)
+      : data(detail::make_variadic_union<T, data_t>(FWD(args)...)),
+        index(static_cast<index_t>(detail::type_index<T, Ts...>))
   {
   }
 
@@ -466,12 +525,7 @@ struct copack<Ts...> {
       noexcept((... && detail::_nothrow_makeable<data_t, Tx, Tx const &>))
     requires detail::is_superset_of<copack, copack<Tx...>> && (not ::std::is_same_v<copack, copack<Tx...>>)
                  && (... && detail::_makeable<data_t, Tx, Tx const &>) && (sizeof...(Tx) > 0)
-      : data(FWD(arg).template _invoke<data_t>([]<typename T>(::std::in_place_type_t<T>, auto &&v) -> data_t {
-          return detail::make_variadic_union<T, data_t>(FWD(v));
-        })),
-        index(FWD(arg).template _invoke<::std::size_t>([]<typename T>(::std::in_place_type_t<T>, auto &&) { //
-          return detail::type_index<T, Ts...>;
-        }))
+      : data(_widened_data(FWD(arg))), index(_widened_index(arg))
   {
   }
 
@@ -483,12 +537,7 @@ struct copack<Ts...> {
       noexcept((... && detail::_nothrow_makeable<data_t, Tx, Tx>))
     requires detail::is_superset_of<copack, copack<Tx...>> && (not ::std::is_same_v<copack, copack<Tx...>>)
                  && (... && detail::_makeable<data_t, Tx, Tx>) && (sizeof...(Tx) > 0)
-      : data(FWD(arg).template _invoke<data_t>([]<typename T>(::std::in_place_type_t<T>, auto &&v) -> data_t {
-          return detail::make_variadic_union<T, data_t>(FWD(v));
-        })),
-        index(FWD(arg).template _invoke<::std::size_t>([]<typename T>(::std::in_place_type_t<T>, auto &&) { //
-          return detail::type_index<T, Ts...>;
-        }))
+      : data(_widened_data(FWD(arg))), index(_widened_index(arg))
   {
   }
 
@@ -502,12 +551,58 @@ struct copack<Ts...> {
       noexcept((... && detail::_nothrow_makeable<data_t, Tx, apply_const_lvalue_t<decltype(arg), Tx &&>>))
     requires ::std::is_same_v<::std::remove_cvref_t<decltype(arg)>, copack<Tx...>>
                  && detail::is_superset_of<copack, copack<Tx...>> && (sizeof...(Tx) > 0)
-      : data(FWD(arg).template _invoke<data_t>([]<typename T>(::std::in_place_type_t<T>, auto &&v) -> data_t {
-          return detail::make_variadic_union<T, data_t>(FWD(v));
+      : data(_widened_data(FWD(arg))), index(_widened_index(arg))
+  {
+  }
+
+  /**
+   * @brief Constructs the alternative `T` in place, passing the allocator on to it
+   *
+   * Uses-allocator construction, as `std::uses_allocator` reports this copack capable of: the
+   * allocator goes to an alternative which takes one and is dropped for one which does not.
+   *
+   * @tparam T The alternative to construct
+   * @param a The allocator
+   * @param args Arguments to construct the alternative from
+   */
+  template <typename Alloc, typename T>
+  constexpr explicit copack(::std::allocator_arg_t, Alloc const &a, ::std::in_place_type_t<T>, auto &&...args)
+    requires has_type<T> && detail::_makeable<data_t, T, T>
+             && requires { detail::_make_using_allocator<T>(a, FWD(args)...); }
+      : data(detail::make_variadic_union<T, data_t>(detail::_make_using_allocator<T>(a, FWD(args)...))),
+        index(static_cast<index_t>(detail::type_index<T, Ts...>))
+  {
+  }
+
+  /**
+   * @brief Constructs the alternative from a value of it, passing the allocator on to it
+   *
+   * @param a The allocator
+   * @param v Value of one alternative
+   */
+  template <typename Alloc, typename T>
+  constexpr copack(::std::allocator_arg_t, Alloc const &a, T &&v)
+    requires has_type<::std::remove_cvref_t<T>>
+             && detail::_makeable<data_t, ::std::remove_cvref_t<T>, ::std::remove_cvref_t<T>>
+             && requires { detail::_make_using_allocator<::std::remove_cvref_t<T>>(a, FWD(v)); }
+      : copack(::std::allocator_arg, a, ::std::in_place_type<::std::remove_cvref_t<T>>, FWD(v))
+  {
+  }
+
+  /**
+   * @brief Copies or moves a copack over the same or a subset of the alternatives, passing the
+   * allocator on to the active alternative
+   *
+   * @param a The allocator
+   * @param arg The copack to copy or move from
+   */
+  template <typename Alloc, some_copack C>
+  constexpr copack(::std::allocator_arg_t, Alloc const &a, C &&arg)
+    requires detail::is_superset_of<copack, ::std::remove_cvref_t<C>> && (::std::remove_cvref_t<C>::size > 0)
+      : data(FWD(arg).template _invoke<data_t>([&a]<typename T>(::std::in_place_type_t<T>, auto &&v) -> data_t {
+          return detail::make_variadic_union<T, data_t>(detail::_make_using_allocator<T>(a, FWD(v)));
         })),
-        index(FWD(arg).template _invoke<::std::size_t>([]<typename T>(::std::in_place_type_t<T>, auto &&) { //
-          return detail::type_index<T, Ts...>;
-        }))
+        index(_widened_index(arg))
   {
   }
 
@@ -1512,6 +1607,13 @@ template <typename Tag, typename Cp, typename Fn>
 } // namespace LIBFN_VERSION
 } // namespace fn
 
+namespace std {
+// Uses-allocator construction of a copack passes the allocator on to the active alternative
+template <typename... Ts, typename Alloc>
+struct uses_allocator<::fn::copack<Ts...>, Alloc>
+    : ::std::bool_constant<(... || ::fn::detail::_uses_allocator<Ts, Alloc>)> {};
+} // namespace std
+
 #include <fn/detail/macro_end.hpp>
 
 #endif // INCLUDE_FN_COPACK
@@ -0,0 +1,323 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_COROUTINE
+#define INCLUDE_FN_COROUTINE
+
+#include <fn/expected.hpp>
+#include <fn/optional.hpp>
+#include <libfn_version.hpp>
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+// The carrier is built from the object get_return_object returns only once the body has finished, as
+// gcc, MSVC and clang 17 do (CWG2563). Clang 16 converted it before the body ran, when there is no
+// result to convert yet; Apple Clang 16 is based on a later LLVM and is not affected. There, this header
+// declares nothing and sets LIBFN_COROUTINE to 0, so that it stays harmless to include (e.g. as a part of
+// the single-header libfn.hpp).
+#if defined(__clang__) && !defined(__apple_build_version__) && (__clang_major__ < 17)
+#define LIBFN_COROUTINE 0
+#else
+#define LIBFN_COROUTINE 1
+#endif
+
+#include <fn/detail/macro_begin.hpp>
+
+#if LIBFN_COROUTINE
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+namespace detail {
+struct _frame_allocation;
+} // namespace detail
+
+/**
+ * @brief A caller-supplied buffer which the frames of carrier coroutines are allocated from
+ *
+ * While a `coroutine_arena::scope` over the arena is alive, every coroutine returning
+ * `fn::expected` or `fn::optional` started on that thread takes its frame from the buffer rather
+ * than from the global heap. A carrier coroutine runs to completion before it returns, so the
+ * frames of nested calls are freed in the reverse order of their allocation and the arena is a
+ * simple stack: memory is handed back as soon as the frame on top is destroyed. When the buffer is
+ * exhausted a frame falls back to the global heap, so the size of the buffer is a performance
+ * choice and never a correctness one.
+ *
+ * The arena is not thread-safe, and must outlive every frame allocated from it.
+ */
+class coroutine_arena final {
+public:
+  /**
+   * @brief The alignment of every frame, and the granularity of the allocations
+   */
+  static constexpr ::std::size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+  /**
+   * @brief Constructs an arena over the buffer, which is not owned
+   *
+   * @param buffer The memory to allocate from; need not be aligned
+   */
+  explicit coroutine_arena(::std::span<::std::byte> buffer) noexcept
+      : top_(_align(buffer.data(), buffer.data() + buffer.size())), end_(buffer.data() + buffer.size()),
+        begin_(top_)
+  {
+  }
+
+  coroutine_arena(coroutine_arena const &) = delete;
+  coroutine_arena &operator=(coroutine_arena const &) = delete;
+
+  class scope;
+
+  /**
+   * @brief Allocates `size` bytes from the top of the arena
+   *
+   * @param size The number of bytes
+   * @return The memory, aligned to `alignment`, or a null pointer if the arena is exhausted
+   */
+  [[nodiscard]] auto allocate(::std::size_t size) noexcept -> void *
+  {
+    ::std::size_t const need = _round(size);
+    if (need > static_cast<::std::size_t>(end_ - top_))
+      return nullptr;
+    void *const result = top_;
+    top_ += need;
+    return result;
+  }
+
+  /**
+   * @brief Returns memory to the arena
+   *
+   * Memory which is not on top of the arena stays in use until everything above it is returned.
+   *
+   * @param p The memory, as returned by `allocate`
+   * @param size The number of bytes, as passed to `allocate`
+   */
+  void deallocate(void *p, ::std::size_t size) noexcept
+  {
+    if (static_cast<::std::byte *>(p) + _round(size) == top_)
+      top_ = static_cast<::std::byte *>(p);
+  }
+
+  /**
+   * @brief The number of bytes currently allocated
+   */
+  [[nodiscard]] auto used() const noexcept -> ::std::size_t { return static_cast<::std::size_t>(top_ - begin_); }
+
+private:
+  static constexpr auto _round(::std::size_t size) noexcept -> ::std::size_t
+  {
+    return (size + alignment - 1) / alignment * alignment;
+  }
+
+  static auto _align(::std::byte *p, ::std::byte *end) noexcept -> ::std::byte *
+  {
+    auto const skip = (alignment - reinterpret_cast<::std::uintptr_t>(p) % alignment) % alignment;
+    return skip < static_cast<::std::size_t>(end - p) ? p + skip : end;
+  }
+
+  ::std::byte *top_;
+  ::std::byte *end_;
+  ::std::byte *begin_;
+
+  static inline thread_local coroutine_arena *current_ = nullptr;
+  friend struct detail::_frame_allocation;
+};
+
+/**
+ * @brief Directs the frames of carrier coroutines started on this thread to an arena
+ *
+ * Scopes nest: the innermost one is in effect, and its end restores the one it replaced. A frame is
+ * returned to the arena it was taken from wherever it is destroyed.
+ */
+class coroutine_arena::scope final {
+public:
+  /**
+   * @brief Makes `arena` the current arena of this thread
+   *
+   * @param arena The arena to allocate frames from
+   */
+  explicit scope(coroutine_arena &arena) noexcept : previous_(::std::exchange(current_, &arena)) {}
+  ~scope() noexcept { current_ = previous_; }
+
+  scope(scope const &) = delete;
+  scope &operator=(scope const &) = delete;
+
+private:
+  coroutine_arena *previous_;
+};
+
+namespace detail {
+
+// A frame is prefixed with the arena it was taken from - null for the global heap - because
+// operator delete is given only the pointer and the size. The prefix keeps the frame aligned.
+struct _frame_allocation {
+  static constexpr ::std::size_t _prefix = coroutine_arena::alignment;
+
+  static auto _place(void *p, coroutine_arena *arena) noexcept -> void *
+  {
+    ::new (p) coroutine_arena *(arena);
+    return static_cast<::std::byte *>(p) + _prefix;
+  }
+
+  // Either of these inlined, gcc pairs the global allocation function inside with the class's own
+  // counterpart of the other, and reports a mismatch
+#if defined(__GNUC__) && !defined(__clang__)
+  [[gnu::noinline]]
+#endif
+  static auto operator new(::std::size_t size) -> void *
+  {
+    coroutine_arena *const arena = coroutine_arena::current_;
+    if (void *const p = arena != nullptr ? arena->allocate(size + _prefix) : nullptr)
+      return _place(p, arena);
+    return _place(::operator new(size + _prefix), nullptr);
+  }
+
+#if defined(__GNUC__) && !defined(__clang__)
+  [[gnu::noinline]]
+#endif
+  static void operator delete(void *frame, ::std::size_t size) noexcept
+  {
+    void *const p = static_cast<::std::byte *>(frame) - _prefix;
+    if (coroutine_arena *const arena = *static_cast<coroutine_arena **>(p))
+      arena->deallocate(p, size + _prefix);
+    else
+      ::operator delete(p);
+  }
+};
+
+template <typename Ret> struct _carrier_promise;
+
+// What get_return_object hands to the caller, converted to the carrier once the body has finished:
+// the frame is gone by then, so the result is built here rather than in the promise. A returned
+// prvalue is materialized exactly once, so the address registered with the promise holds; a move
+// before the body has finished registers the new one.
+template <typename Ret> struct _carrier_return final {
+  _carrier_promise<Ret> *promise_;
+  ::std::optional<Ret> result_ = {};
+
+  explicit _carrier_return(_carrier_promise<Ret> &promise) noexcept : promise_(&promise)
+  {
+    promise_->return_ = this;
+  }
+  _carrier_return(_carrier_return &&other) noexcept(::std::is_nothrow_move_constructible_v<Ret>)
+      : promise_(other.promise_), result_(::std::move(other.result_))
+  {
+    if (not result_.has_value())
+      promise_->return_ = this;
+  }
+  _carrier_return &operator=(_carrier_return &&) = delete;
+
+  operator Ret() && { return *::std::move(result_); }
+};
+
+// The operand of co_await stays alive to the end of the full-expression, so it is held by reference.
+// A value is handed on the way the carrier was: an lvalue carrier lends a reference, an rvalue one
+// moves its value out - except a reference value, which is never owned by the carrier.
+template <typename C> struct _await_value {
+  using type = decltype(*::std::declval<C>());
+};
+template <typename C>
+  requires(not ::std::is_lvalue_reference_v<C>) && (not ::std::is_void_v<typename ::std::remove_cvref_t<C>::value_type>)
+          && (not ::std::is_reference_v<typename ::std::remove_cvref_t<C>::value_type>)
+struct _await_value<C> {
+  using type = ::std::remove_cv_t<typename ::std::remove_cvref_t<C>::value_type>;
+};
+template <typename C>
+  requires ::std::is_void_v<typename ::std::remove_cvref_t<C>::value_type>
+struct _await_value<C> {
+  using type = void;
+};
+
+template <typename Ret, typename C> struct _carrier_awaiter final {
+  C carrier_;
+
+  [[nodiscard]] constexpr auto await_ready() const noexcept -> bool { return carrier_.has_value(); }
+
+  // The short-circuit: the enclosing coroutine's result is built from the failure, and the frame is
+  // destroyed without resuming - the caller sees the function return.
+  void await_suspend(::std::coroutine_handle<_carrier_promise<Ret>> handle)
+  {
+    if constexpr (some_expected<Ret>)
+      handle.promise().return_->result_.emplace(::fn::unexpect, FWD(carrier_).error());
+    else
+      handle.promise().return_->result_.emplace(::std::nullopt);
+    handle.destroy();
+  }
+
+  constexpr auto await_resume() -> typename _await_value<C>::type
+  {
+    if constexpr (not ::std::is_void_v<typename _await_value<C>::type>)
+      return *FWD(carrier_);
+  }
+};
+
+template <typename Ret> struct _carrier_promise_base : _frame_allocation {
+  _carrier_return<Ret> *return_ = nullptr;
+
+  [[nodiscard]] auto get_return_object() noexcept -> _carrier_return<Ret>
+  {
+    return _carrier_return<Ret>{static_cast<_carrier_promise<Ret> &>(*this)};
+  }
+  [[nodiscard]] static constexpr auto initial_suspend() noexcept -> ::std::suspend_never { return {}; }
+  [[nodiscard]] static constexpr auto final_suspend() noexcept -> ::std::suspend_never { return {}; }
+  // An exception leaves the frame at the final suspend point, and reaches the caller
+  [[noreturn]] static void unhandled_exception() { throw; }
+
+  // An expected takes the error of any expected its error type can be built from - a copack error
+  // widens into a copack which has its alternatives, exactly as the verbs widen it; an optional takes
+  // the empty state of any optional. Nothing else can be awaited: these coroutines never suspend.
+  template <typename C>
+    requires(some_expected<Ret> && some_expected<C>
+             && ::std::is_constructible_v<Ret, ::fn::unexpect_t, decltype(::std::declval<C>().error())>)
+            || (some_optional<Ret> && some_optional<C>)
+  [[nodiscard]] constexpr auto await_transform(C &&carrier) noexcept -> _carrier_awaiter<Ret, C &&>
+  {
+    return {FWD(carrier)};
+  }
+};
+
+template <typename Ret> struct _carrier_promise : _carrier_promise_base<Ret> {
+  template <typename U = Ret>
+    requires ::std::is_constructible_v<Ret, U>
+  void return_value(U &&v)
+  {
+    this->return_->result_.emplace(FWD(v));
+  }
+};
+
+template <typename Ret>
+  requires ::std::is_void_v<typename Ret::value_type>
+struct _carrier_promise<Ret> : _carrier_promise_base<Ret> {
+  void return_void() { this->return_->result_.emplace(); }
+};
+
+} // namespace detail
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+namespace std {
+// A function returning an fn::expected or an fn::optional is a coroutine where its body says so
+template <typename T, typename E, typename... Args> struct coroutine_traits<::fn::expected<T, E>, Args...> {
+  using promise_type = ::fn::detail::_carrier_promise<::fn::expected<T, E>>;
+};
+
+template <typename T, typename... Args> struct coroutine_traits<::fn::optional<T>, Args...> {
+  using promise_type = ::fn::detail::_carrier_promise<::fn::optional<T>>;
+};
+} // namespace std
+
+#endif // LIBFN_COROUTINE
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_COROUTINE
@@ -123,8 +123,20 @@ namespace _apply_detail {
 // or copack's own `apply` when dispatching into one, and folding-then-recursing when several operands
 // must be joined first (that fold constructs a pack, which can throw). The chain terminates because
 // every step strictly reduces the number of pack/copack operands.
+// A `boxed` leading argument is handed over as it is only to a callable which cannot take its value
+template <typename... Args> constexpr bool _unboxable = false;
+template <typename Fn, typename Arg, typename... Args>
+  requires _some_boxed<Arg>
+constexpr bool _unboxable<Fn, Arg, Args...> = ::std::is_invocable_v<Fn, decltype(*::std::declval<Arg>()), Args...>;
+template <typename Ret, typename Fn, typename... Args> constexpr bool _unboxable_r = false;
+template <typename Ret, typename Fn, typename Arg, typename... Args>
+  requires _some_boxed<Arg>
+constexpr bool _unboxable_r<Ret, Fn, Arg, Args...>
+    = ::std::is_invocable_r_v<Ret, Fn, decltype(*::std::declval<Arg>()), Args...>;
+
 template <typename Fn, typename... Args>
-  requires(not(... || (_some_pack<Args> || _some_copack<Args>))) && ::std::is_invocable_v<Fn, Args...>
+  requires(not(... || (_some_pack<Args> || _some_copack<Args>))) && (not _unboxable<Fn, Args...>)
+          && ::std::is_invocable_v<Fn, Args...>
 [[nodiscard]] constexpr auto apply(Fn &&fn, Args &&...args) noexcept(::std::is_nothrow_invocable_v<Fn, Args...>)
     -> DEDUCED_RETURN(::std::invoke(FWD(fn), FWD(args)...))
 {
@@ -156,6 +168,23 @@ template <typename Fn, typename Arg, typename... Args>
   return FWD(arg).apply(FWD(fn), FWD(args)...);
 }
 
+// A leading `boxed` argument, such as a copack alternative stored out of line, is handed over as
+// the value it holds, keeping its value category; the value then takes any of the arms above. A
+// callable which takes only the box - a box is never made implicitly from a value - gets the very
+// box, invoked directly above.
+template <typename Fn, typename Arg, typename... Args>
+  requires _some_boxed<Arg> && (not(... || (_some_pack<Args> || _some_copack<Args>)))
+           && (_unboxable<Fn, Arg, Args...> || not ::std::is_invocable_v<Fn, Arg, Args...>)
+           && requires(Fn &&fn, Arg &&arg, Args &&...args) {
+                _apply_detail::apply(FWD(fn), *FWD(arg), FWD(args)...);
+              }
+[[nodiscard]] constexpr auto apply(Fn &&fn, Arg &&arg, Args &&...args) //
+    noexcept(noexcept(_apply_detail::apply(FWD(fn), *FWD(arg), FWD(args)...)))
+        -> DEDUCED_RETURN(_apply_detail::apply(FWD(fn), *FWD(arg), FWD(args)...))
+{
+  return _apply_detail::apply(FWD(fn), *FWD(arg), FWD(args)...);
+}
+
 template <typename Fn, typename Arg, typename Arg0, typename... Args>
   requires((_some_pack<Arg0> || _some_copack<Arg0>) || ... || (_some_pack<Args> || _some_copack<Args>))
           && requires(Fn &&fn, Arg &&arg, Arg0 &&arg0, Args &&...args) {
@@ -174,7 +203,8 @@ template <typename Fn, typename Arg, typename Arg0, typename... Args>
 }
 
 template <typename Ret, typename Fn, typename... Args>
-  requires(not(... || (_some_pack<Args> || _some_copack<Args>))) && ::std::is_invocable_r_v<Ret, Fn, Args...>
+  requires(not(... || (_some_pack<Args> || _some_copack<Args>))) && (not _unboxable_r<Ret, Fn, Args...>)
+          && ::std::is_invocable_r_v<Ret, Fn, Args...>
 [[nodiscard]] constexpr auto apply_r(Fn &&fn, Args &&...args) //
     noexcept(::std::is_nothrow_invocable_r_v<Ret, Fn, Args...>)
         -> DEDUCED_RETURN(::pfn::invoke_r<Ret>(FWD(fn), FWD(args)...))
@@ -278,6 +308,18 @@ template <typename Ret, typename Fn, typename Arg, typename... Args>
   return FWD(arg).template apply_r<Ret>(FWD(fn), FWD(args)...);
 }
 
+template <typename Ret, typename Fn, typename Arg, typename... Args>
+  requires _some_boxed<Arg> && (not(... || (_some_pack<Args> || _some_copack<Args>)))
+           && (_unboxable_r<Ret, Fn, Arg, Args...> || not ::std::is_invocable_r_v<Ret, Fn, Arg, Args...>)
+           && requires(Fn &&fn, Arg &&arg, Args &&...args) {
+                _apply_detail::apply_r<Ret>(FWD(fn), *FWD(arg), FWD(args)...);
+              }
+[[nodiscard]] constexpr auto apply_r(Fn &&fn, Arg &&arg, Args &&...args) //
+    noexcept(noexcept(_apply_detail::apply_r<Ret>(FWD(fn), *FWD(arg), FWD(args)...))) -> Ret
+{
+  return _apply_detail::apply_r<Ret>(FWD(fn), *FWD(arg), FWD(args)...);
+}
+
 template <typename Ret, typename Fn, typename Arg, typename Arg0, typename... Args>
   requires((_some_pack<Arg0> || _some_copack<Arg0>) || ... || (_some_pack<Args> || _some_copack<Args>))
           && requires(Fn &&fn, Arg &&arg, Arg0 &&arg0, Args &&...args) {
@@ -83,6 +83,16 @@ template <typename... Ts> constexpr bool _is_copack<::fn::copack<Ts...> const &>
 template <typename T>
 concept _some_copack = detail::_is_copack<T &>;
 } // namespace detail
+
+// out-of-line storage of a value
+template <typename T> class boxed;
+namespace detail {
+template <typename T> constexpr bool _is_some_boxed = false;
+template <typename T> constexpr bool _is_some_boxed<::fn::boxed<T> &> = true;
+template <typename T> constexpr bool _is_some_boxed<::fn::boxed<T> const &> = true;
+template <typename T>
+concept _some_boxed = _is_some_boxed<T &>;
+} // namespace detail
 } // namespace LIBFN_VERSION
 } // namespace fn
 
@@ -0,0 +1,105 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_DETAIL_USES_ALLOCATOR
+#define INCLUDE_FN_DETAIL_USES_ALLOCATOR
+
+#include <fn/detail/fwd.hpp>
+#include <fn/detail/meta.hpp>
+#include <libfn_version.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn::inline LIBFN_VERSION::detail {
+
+// Whether a payload takes an allocator. A pack is an aggregate with no allocator-extended
+// constructors, so it cannot answer `std::uses_allocator` itself; a carrier holding one builds it
+// element by element instead, and asks of the elements. A reference element is bound, never built.
+template <typename T, typename Alloc> constexpr bool _uses_allocator = ::std::uses_allocator_v<T, Alloc>;
+template <typename Alloc> constexpr bool _uses_allocator<void, Alloc> = false;
+template <typename Alloc, typename... Ts>
+constexpr bool _uses_allocator<::fn::pack<Ts...>, Alloc>
+    = (... || ((not ::std::is_reference_v<Ts>) && _uses_allocator<Ts, Alloc>));
+
+// Builds a payload of a carrier constructed with an allocator, as uses-allocator construction does
+// ([allocator.uses.construction]): the allocator is passed on where `T` takes it and dropped where
+// it does not. The result is a prvalue, so a carrier initializing its storage from a callable
+// returning it constructs the payload in place.
+template <typename T, typename Alloc, typename... Args>
+  requires(not _some_pack<T>) && requires(Alloc const &a, Args &&...args) {
+    ::std::make_obj_using_allocator<T>(a, FWD(args)...);
+  }
+[[nodiscard]] constexpr auto _make_using_allocator(Alloc const &a, Args &&...args) -> T
+{
+  return ::std::make_obj_using_allocator<T>(a, FWD(args)...);
+}
+
+template <typename T, typename Alloc, typename Arg>
+  requires ::std::is_reference_v<T> && ::std::is_constructible_v<T, Arg>
+[[nodiscard]] constexpr auto _make_element_using_allocator(Alloc const &, Arg &&arg) noexcept -> T
+{
+  return FWD(arg);
+}
+
+template <typename T, typename Alloc, typename Arg>
+  requires(not ::std::is_reference_v<T>) && requires(Alloc const &a, Arg &&arg) {
+    ::fn::detail::_make_using_allocator<T>(a, FWD(arg));
+  }
+[[nodiscard]] constexpr auto _make_element_using_allocator(Alloc const &a, Arg &&arg) -> T
+{
+  return ::fn::detail::_make_using_allocator<T>(a, FWD(arg));
+}
+
+template <typename T, typename Alloc, ::std::size_t... Is, typename... Args>
+[[nodiscard]] constexpr auto _make_pack_using_allocator(Alloc const &a, ::std::index_sequence<Is...>, Args &&...args)
+    -> T
+{
+  return T{::fn::detail::_make_element_using_allocator<::std::tuple_element_t<Is, T>>(a, FWD(args))...};
+}
+
+template <typename T, typename Alloc, ::std::size_t... Is, typename Src>
+[[nodiscard]] constexpr auto _copy_pack_using_allocator(Alloc const &a, ::std::index_sequence<Is...>, Src &&src) -> T
+{
+  return T{::fn::detail::_make_element_using_allocator<::std::tuple_element_t<Is, T>>(a, get<Is>(FWD(src)))...};
+}
+
+// A pack from one argument for each element, each built with the allocator; asked only once the
+// counts are known to agree, as the two lists are expanded together
+template <typename T, typename Alloc, typename... Args> constexpr bool _pack_using_allocator = false;
+template <typename... Ts, typename Alloc, typename... Args>
+constexpr bool _pack_using_allocator<::fn::pack<Ts...>, Alloc, Args...>
+    = (... && requires {
+        ::fn::detail::_make_element_using_allocator<Ts>(::std::declval<Alloc const &>(), ::std::declval<Args>());
+      });
+
+template <typename T, typename Alloc, typename... Args>
+  requires _some_pack<T> && (::std::tuple_size_v<T> == sizeof...(Args))
+           && (not(sizeof...(Args) == 1 && (... && ::std::is_same_v<::std::remove_cvref_t<Args>, T>)))
+           && _pack_using_allocator<T, Alloc, Args...>
+[[nodiscard]] constexpr auto _make_using_allocator(Alloc const &a, Args &&...args) -> T
+{
+  return ::fn::detail::_make_pack_using_allocator<T>(a, ::std::index_sequence_for<Args...>{}, FWD(args)...);
+}
+
+// A pack from a pack of the same type, element by element, each built with the allocator
+template <typename T, typename Alloc, typename Src>
+  requires _some_pack<T> && ::std::is_same_v<::std::remove_cvref_t<Src>, T>
+[[nodiscard]] constexpr auto _make_using_allocator(Alloc const &a, Src &&src) -> T
+{
+  return ::fn::detail::_copy_pack_using_allocator<T>(a, ::std::make_index_sequence<::std::tuple_size_v<T>>{},
+                                                      FWD(src));
+}
+
+} // namespace fn::inline LIBFN_VERSION::detail
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_DETAIL_USES_ALLOCATOR
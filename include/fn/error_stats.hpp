@@ -0,0 +1,170 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_ERROR_STATS
+#define INCLUDE_FN_ERROR_STATS
+
+#include <fn/concepts.hpp>
+#include <fn/copack.hpp>
+#include <fn/functor.hpp>
+#include <libfn_version.hpp>
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+template <typename E> class error_stats;
+
+/**
+ * @brief Counts how often each alternative of a `copack` error occurs
+ *
+ * One relaxed atomic counter per alternative, in the canonical order of the alternatives, each on
+ * a cache line of its own so that threads recording different errors do not contend. Recording is
+ * a single increment indexed by the copack's discriminant, with no dispatch on the type. Reading
+ * and resetting are wait-free, counter by counter: a snapshot taken while errors are recorded
+ * is not a single point in time, but every increment is seen exactly once by a `reset`.
+ *
+ * @tparam Es The alternatives of the copack, as in `copack<Es...>`
+ */
+template <typename... Es>
+  requires(sizeof...(Es) > 0)
+class error_stats<copack<Es...>> final {
+  // A fixed line size: std::hardware_destructive_interference_size varies with compiler flags,
+  // which would make the layout of this type differ between translation units.
+  struct alignas(64) _counter final {
+    ::std::atomic<::std::uint64_t> value = 0;
+  };
+  // Recording is an observation, made through the const reference a pipeline step holds
+  mutable ::std::array<_counter, sizeof...(Es)> counters_ = {};
+
+public:
+  /**
+   * @brief The error type counted
+   */
+  using error_type = copack<Es...>;
+  /**
+   * @brief The snapshot of all the counters, in the canonical order of the alternatives
+   */
+  using snapshot_type = ::std::array<::std::uint64_t, sizeof...(Es)>;
+  /**
+   * @brief The number of alternatives, and of counters
+   */
+  static constexpr ::std::size_t size = sizeof...(Es);
+
+  error_stats() noexcept = default;
+  error_stats(error_stats const &) = delete;
+  error_stats &operator=(error_stats const &) = delete;
+
+  /**
+   * @brief Counts one occurrence of the active alternative
+   *
+   * @param error The error
+   */
+  void record(error_type const &error) const noexcept
+  {
+    counters_[error.index].value.fetch_add(1, ::std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief The count of the alternative at the index
+   *
+   * @param index The index of the alternative, as in `copack::index`
+   */
+  [[nodiscard]] auto count(::std::size_t index) const noexcept -> ::std::uint64_t
+  {
+    return counters_[index].value.load(::std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief The count of the alternative `T`
+   *
+   * @tparam T One of the alternatives
+   */
+  template <typename T>
+    requires(error_type::template has_type<T>)
+  [[nodiscard]] auto count() const noexcept -> ::std::uint64_t
+  {
+    return count(detail::type_index<T, Es...>);
+  }
+
+  /**
+   * @brief The counts of all the alternatives, read one after another
+   */
+  [[nodiscard]] auto snapshot() const noexcept -> snapshot_type
+  {
+    snapshot_type ret = {};
+    for (::std::size_t i = 0; i < size; ++i)
+      ret[i] = count(i);
+    return ret;
+  }
+
+  /**
+   * @brief Sets every counter to zero, returning the counts taken from it
+   */
+  auto reset() noexcept -> snapshot_type
+  {
+    snapshot_type ret = {};
+    for (::std::size_t i = 0; i < size; ++i)
+      ret[i] = counters_[i].value.exchange(0, ::std::memory_order_relaxed);
+    return ret;
+  }
+};
+
+/**
+ * @brief Counts the errors passing through a pipeline, passing the operand through unchanged
+ *
+ * An `inspect_error` whose only observation is `stats.record(error)`: the carrier is an `expected`
+ * whose error is exactly the copack the `fn::error_stats` counts. The stats are held by reference
+ * and must outlive the pipeline step.
+ *
+ * Use through the `fn::count_errors` nielbloid.
+ */
+constexpr inline struct count_errors_t final {
+  /**
+   * @brief Counts the errors passing through, into the stats
+   * @param stats The counters, held by reference
+   * @return A functor that will record the error, if any
+   */
+  template <typename E>
+  [[nodiscard]] constexpr auto operator()(error_stats<E> &stats) const noexcept
+      -> functor<count_errors_t, error_stats<E> &>
+  {
+    return {stats};
+  }
+
+  struct apply;
+} count_errors = {}; ///< Counts the errors in passing: `x | count_errors(stats)`
+
+struct count_errors_t::apply final {
+  /**
+   * @brief Records the error, when one is present
+   *
+   * @param v The monad
+   * @param stats The counters
+   * @return The operand, forwarded unchanged
+   */
+  template <some_expected V, typename E>
+  [[nodiscard]] auto operator()(V &&v, error_stats<E> const &stats) const noexcept -> V &&
+    requires ::std::same_as<typename ::std::remove_cvref_t<V>::error_type, E>
+  {
+    if (not v.has_value())
+      stats.record(v.error());
+    return FWD(v);
+  }
+};
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_ERROR_STATS
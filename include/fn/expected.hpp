@@ -12,9 +12,11 @@
 
 #include <fn/copack.hpp>
 #include <fn/detail/traits.hpp>
+#include <fn/detail/uses_allocator.hpp>
 #include <fn/fwd.hpp>
 #include <fn/pack.hpp>
 
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -211,6 +213,36 @@ struct _nothrow_or_else<T, Fn, ErrArg, ValArg> {
         && (::std::is_void_v<T> || empty_copack<T> || _nothrow_initializable<type, ::std::in_place_t, ValArg>);
 };
 
+// The error side of a value-side operation: the error carried into the result, widened as the
+// result's error type requires. Out of line and cold in the LIBFN_COLD_ERRORS mode, so that once the
+// operations are inlined the value path is not interleaved with rebuilding the error; the compiler
+// then also treats the branch reaching it as unlikely. The mode changes code generation only, never
+// a type or a result, and like NDEBUG it should be chosen for a whole program.
+template <typename Ret, typename... Args>
+#if defined(LIBFN_COLD_ERRORS) && (defined(__GNUC__) || defined(__clang__))
+[[gnu::cold, gnu::noinline]]
+#elif defined(LIBFN_COLD_ERRORS) && defined(_MSC_VER)
+__declspec(noinline)
+#endif
+constexpr auto _carry_error(Args &&...args) //
+    noexcept(::std::is_nothrow_constructible_v<Ret, ::fn::unexpect_t, Args &&...>) -> Ret
+{
+  return Ret(::fn::unexpect, FWD(args)...);
+}
+
+// As above, where the error is first made by a callable - the error handler of `filter` - so that
+// the call is outlined along with the construction of the result.
+template <typename Ret, typename Fn>
+#if defined(LIBFN_COLD_ERRORS) && (defined(__GNUC__) || defined(__clang__))
+[[gnu::cold, gnu::noinline]]
+#elif defined(LIBFN_COLD_ERRORS) && defined(_MSC_VER)
+__declspec(noinline)
+#endif
+constexpr auto _make_error(Fn &&fn) noexcept(noexcept(Ret(::fn::unexpect, FWD(fn)()))) -> Ret
+{
+  return Ret(::fn::unexpect, FWD(fn)());
+}
+
 // Storage layer for ::fn::expected. Inherits the standard-conformant base from
 // pfn, then hides the four monadic static helpers with copack-widening variants
 // that materialise their result via `expected_policy::template type<U, G>`.
@@ -226,6 +258,16 @@ template <typename T, typename E> struct _expected_base : ::pfn::detail::_expect
   using _pfn_base = ::pfn::detail::_expected_base<T, E, expected_policy>;
   using _pfn_base::_pfn_base;
 
+  // An expected of this type, its value direct-non-list-initialized from the thunk's result; for the
+  // verbs which are not members, such as value_or_else
+  template <typename Fn>
+  [[nodiscard]] static constexpr auto _value_from_invoke(Fn &&fn) //
+      noexcept(noexcept(::fn::expected<T, E>(::pfn::detail::_expected_from_invoke, ::std::in_place, FWD(fn))))
+          -> ::fn::expected<T, E>
+  {
+    return ::fn::expected<T, E>(::pfn::detail::_expected_from_invoke, ::std::in_place, FWD(fn));
+  }
+
   // and_then, non-void value type
   template <typename Self, typename Fn>
   static constexpr auto _and_then(Self &&self, Fn &&fn) //
@@ -247,7 +289,7 @@ template <typename T, typename E> struct _expected_base : ::pfn::detail::_expect
             _pfn_base::_value(FWD(self)), FWD(fn));
       else {
         if constexpr (not empty_copack<E>)
-          return type(::fn::unexpect, _pfn_base::_error(FWD(self)));
+          return ::fn::detail::_carry_error<type>(_pfn_base::_error(FWD(self)));
         else
           ::pfn::unreachable(); // LCOV_EXCL_LINE
       }
@@ -259,7 +301,7 @@ template <typename T, typename E> struct _expected_base : ::pfn::detail::_expect
         if (self.has_value())
           return ::fn::detail::_apply(FWD(fn), _pfn_base::_value(FWD(self)));
         else
-          return type(::fn::unexpect, _pfn_base::_error(FWD(self)));
+          return ::fn::detail::_carry_error<type>(_pfn_base::_error(FWD(self)));
       } else {
         using new_error_type = copack_for<E, typename type::error_type>;
         using new_type = ::fn::expected<typename type::value_type, new_error_type>;
@@ -272,13 +314,13 @@ template <typename T, typename E> struct _expected_base : ::pfn::detail::_expect
               return new_type{::std::in_place};
           else {
             if constexpr (not empty_copack<typename type::error_type>)
-              return new_type{::fn::unexpect, ::std::move(t).error()};
+              return ::fn::detail::_carry_error<new_type>(::std::move(t).error());
             else
               ::pfn::unreachable(); // LCOV_EXCL_LINE
           }
         } else {
           if constexpr (not empty_copack<E>)
-            return new_type(::fn::unexpect, _pfn_base::_error(FWD(self)));
+            return ::fn::detail::_carry_error<new_type>(_pfn_base::_error(FWD(self)));
           else
             ::pfn::unreachable(); // LCOV_EXCL_LINE
         }
@@ -301,7 +343,7 @@ template <typename T, typename E> struct _expected_base : ::pfn::detail::_expect
       if (self.has_value())
         return ::fn::detail::_apply(FWD(fn));
       else
-        return type(::fn::unexpect, _pfn_base::_error(FWD(self)));
+        return ::fn::detail::_carry_error<type>(_pfn_base::_error(FWD(self)));
     } else {
       using new_error_type = copack_for<E, typename type::error_type>;
       using new_type = ::fn::expected<typename type::value_type, new_error_type>;
@@ -314,13 +356,13 @@ template <typename T, typename E> struct _expected_base : ::pfn::detail::_expect
             return new_type{::std::in_place};
         else {
           if constexpr (not empty_copack<typename type::error_type>)
-            return new_type{::fn::unexpect, ::std::move(t).error()};
+            return ::fn::detail::_carry_error<new_type>(::std::move(t).error());
           else
             ::pfn::unreachable(); // LCOV_EXCL_LINE
         }
       } else {
         if constexpr (not empty_copack<E>)
-          return new_type(::fn::unexpect, _pfn_base::_error(FWD(self)));
+          return ::fn::detail::_carry_error<new_type>(_pfn_base::_error(FWD(self)));
         else
           ::pfn::unreachable(); // LCOV_EXCL_LINE
       }
@@ -411,7 +453,7 @@ template <typename T, typename E> struct _expected_base : ::pfn::detail::_expect
             else
               ::pfn::unreachable(); // LCOV_EXCL_LINE
           } else
-            return new_type{::fn::unexpect, ::std::move(t).error()};
+            return ::fn::detail::_carry_error<new_type>(::std::move(t).error());
         }
       }
     }
@@ -451,7 +493,7 @@ template <typename T, typename E> struct _expected_base : ::pfn::detail::_expect
           return ::fn::detail::_apply(FWD(fn), _pfn_base::_value(FWD(self)));
         });
     else
-      return type(::fn::unexpect, _pfn_base::_error(FWD(self)));
+      return ::fn::detail::_carry_error<type>(_pfn_base::_error(FWD(self)));
   }
 
   // transform, value type is a copack (delegates to copack::transform). The callback is constrained here,
@@ -474,7 +516,7 @@ template <typename T, typename E> struct _expected_base : ::pfn::detail::_expect
         return type(::pfn::detail::_expected_from_invoke, ::std::in_place,
                     [&fn, &self]() -> decltype(auto) { return _pfn_base::_value(FWD(self)).transform(FWD(fn)); });
     else
-      return type(::fn::unexpect, _pfn_base::_error(FWD(self)));
+      return ::fn::detail::_carry_error<type>(_pfn_base::_error(FWD(self)));
   }
 
   // transform, value type is the empty copack: a value can never be constructed, so the callback can
@@ -507,7 +549,7 @@ template <typename T, typename E> struct _expected_base : ::pfn::detail::_expect
         return type(::pfn::detail::_expected_from_invoke, ::std::in_place,
                     [&fn]() -> decltype(auto) { return ::fn::detail::_apply(FWD(fn)); });
     else
-      return type(::fn::unexpect, _pfn_base::_error(FWD(self)));
+      return ::fn::detail::_carry_error<type>(_pfn_base::_error(FWD(self)));
   }
 
   // transform_error, error type is not a copack (the value-copy conjunct is spelled via
@@ -1027,6 +1069,86 @@ public:
   {
   }
 
+  // Uses-allocator construction, as `std::uses_allocator` reports this carrier capable of: the
+  // allocator is passed on to the value or error constructed, where it takes one.
+  /**
+   * @brief Default constructor, passing the allocator on to the value
+   */
+  template <class Alloc>
+  constexpr expected(::std::allocator_arg_t, Alloc const &a)
+    requires requires { detail::_make_using_allocator<T>(a); }
+      : _base(::pfn::detail::_expected_from_invoke, ::std::in_place,
+              [&a]() -> T { return detail::_make_using_allocator<T>(a); })
+  {
+  }
+  /**
+   * @brief Constructs the value in place from the arguments, passing the allocator on to it
+   */
+  template <class Alloc, class... Args>
+  constexpr explicit expected(::std::allocator_arg_t, Alloc const &a, ::std::in_place_t, Args &&...args)
+    requires requires { detail::_make_using_allocator<T>(a, FWD(args)...); }
+      : _base(::pfn::detail::_expected_from_invoke, ::std::in_place,
+              [&]() -> T { return detail::_make_using_allocator<T>(a, FWD(args)...); })
+  {
+  }
+  /**
+   * @brief Constructs the error in place from the arguments, passing the allocator on to it
+   */
+  template <class Alloc, class... Args>
+  constexpr explicit expected(::std::allocator_arg_t, Alloc const &a, ::fn::unexpect_t, Args &&...args)
+    requires requires { detail::_make_using_allocator<Err>(a, FWD(args)...); }
+      : _base(::pfn::detail::_expected_from_invoke, ::fn::unexpect,
+              [&]() -> Err { return detail::_make_using_allocator<Err>(a, FWD(args)...); })
+  {
+  }
+  /**
+   * @brief Constructs the value from a value, passing the allocator on to it
+   */
+  template <class Alloc, class U = ::std::remove_cv_t<T>>
+  constexpr explicit(not ::std::is_convertible_v<U, T>) expected(::std::allocator_arg_t, Alloc const &a, U &&v)
+    requires(_base::template _can_convert<U>::value) && requires { detail::_make_using_allocator<T>(a, FWD(v)); }
+      : expected(::std::allocator_arg, a, ::std::in_place, FWD(v))
+  {
+  }
+  /**
+   * @brief Constructs the error from an `unexpected`, passing the allocator on to it
+   */
+  template <class Alloc, class G>
+  constexpr expected(::std::allocator_arg_t, Alloc const &a, ::fn::unexpected<G> const &g)
+    requires requires { detail::_make_using_allocator<Err>(a, g.error()); }
+      : expected(::std::allocator_arg, a, ::fn::unexpect, g.error())
+  {
+  }
+  template <class Alloc, class G>
+  constexpr expected(::std::allocator_arg_t, Alloc const &a, ::fn::unexpected<G> &&g)
+    requires requires { detail::_make_using_allocator<Err>(a, ::std::move(g).error()); }
+      : expected(::std::allocator_arg, a, ::fn::unexpect, ::std::move(g).error())
+  {
+  }
+  /**
+   * @brief Copies or moves a carrier, passing the allocator on to the value or error
+   */
+  template <class Alloc, class U, class G>
+  constexpr expected(::std::allocator_arg_t, Alloc const &a, expected<U, G> const &s)
+    requires requires {
+      detail::_make_using_allocator<T>(a, *s);
+      detail::_make_using_allocator<Err>(a, s.error());
+    }
+      : expected(s.has_value() ? expected(::std::allocator_arg, a, ::std::in_place, *s)
+                               : expected(::std::allocator_arg, a, ::fn::unexpect, s.error()))
+  {
+  }
+  template <class Alloc, class U, class G>
+  constexpr expected(::std::allocator_arg_t, Alloc const &a, expected<U, G> &&s)
+    requires requires {
+      detail::_make_using_allocator<T>(a, *::std::move(s));
+      detail::_make_using_allocator<Err>(a, ::std::move(s).error());
+    }
+      : expected(s.has_value() ? expected(::std::allocator_arg, a, ::std::in_place, *::std::move(s))
+                               : expected(::std::allocator_arg, a, ::fn::unexpect, ::std::move(s).error()))
+  {
+  }
+
   /**
    * @brief Copy constructor; not available on this carrier
    */
@@ -1735,6 +1857,63 @@ public:
   {
   }
 
+  // Uses-allocator construction, as `std::uses_allocator` reports this carrier capable of: the
+  // allocator is passed on to the error constructed, where it takes one.
+  /**
+   * @brief Default constructor; the allocator is unused
+   */
+  template <class Alloc> constexpr expected(::std::allocator_arg_t, Alloc const &) noexcept : _base(::std::in_place) {}
+  /**
+   * @brief Constructs the value; the allocator is unused
+   */
+  template <class Alloc>
+  constexpr explicit expected(::std::allocator_arg_t, Alloc const &, ::std::in_place_t) noexcept
+      : _base(::std::in_place)
+  {
+  }
+  /**
+   * @brief Constructs the error in place from the arguments, passing the allocator on to it
+   */
+  template <class Alloc, class... Args>
+  constexpr explicit expected(::std::allocator_arg_t, Alloc const &a, ::fn::unexpect_t, Args &&...args)
+    requires requires { detail::_make_using_allocator<Err>(a, FWD(args)...); }
+      : _base(::pfn::detail::_expected_from_invoke, ::fn::unexpect,
+              [&]() -> Err { return detail::_make_using_allocator<Err>(a, FWD(args)...); })
+  {
+  }
+  /**
+   * @brief Constructs the error from an `unexpected`, passing the allocator on to it
+   */
+  template <class Alloc, class G>
+  constexpr expected(::std::allocator_arg_t, Alloc const &a, ::fn::unexpected<G> const &g)
+    requires requires { detail::_make_using_allocator<Err>(a, g.error()); }
+      : expected(::std::allocator_arg, a, ::fn::unexpect, g.error())
+  {
+  }
+  template <class Alloc, class G>
+  constexpr expected(::std::allocator_arg_t, Alloc const &a, ::fn::unexpected<G> &&g)
+    requires requires { detail::_make_using_allocator<Err>(a, ::std::move(g).error()); }
+      : expected(::std::allocator_arg, a, ::fn::unexpect, ::std::move(g).error())
+  {
+  }
+  /**
+   * @brief Copies or moves a carrier, passing the allocator on to the error
+   */
+  template <class Alloc, class G>
+  constexpr expected(::std::allocator_arg_t, Alloc const &a, expected<void, G> const &s)
+    requires requires { detail::_make_using_allocator<Err>(a, s.error()); }
+      : expected(s.has_value() ? expected(::std::in_place)
+                               : expected(::std::allocator_arg, a, ::fn::unexpect, s.error()))
+  {
+  }
+  template <class Alloc, class G>
+  constexpr expected(::std::allocator_arg_t, Alloc const &a, expected<void, G> &&s)
+    requires requires { detail::_make_using_allocator<Err>(a, ::std::move(s).error()); }
+      : expected(s.has_value() ? expected(::std::in_place)
+                               : expected(::std::allocator_arg, a, ::fn::unexpect, ::std::move(s).error()))
+  {
+  }
+
   /**
    * @brief Copy constructor; not available on this carrier
    */
@@ -2787,6 +2966,13 @@ template <typename Lh, some_expected_void Rh>
 } // namespace LIBFN_VERSION
 } // namespace fn
 
+namespace std {
+// Uses-allocator construction of an expected passes the allocator on to the value or error
+template <class T, class Err, class Alloc>
+struct uses_allocator<::fn::expected<T, Err>, Alloc>
+    : ::std::bool_constant<::fn::detail::_uses_allocator<T, Alloc> || ::fn::detail::_uses_allocator<Err, Alloc>> {};
+} // namespace std
+
 #include <fn/detail/macro_end.hpp>
 
 #endif // INCLUDE_FN_EXPECTED
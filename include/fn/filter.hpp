@@ -106,8 +106,9 @@ struct filter_t::apply final {
     using type = ::std::remove_cvref_t<V>;
     if (::std::as_const(v).has_value()) {
       bool const keep = ::fn::apply(FWD(pred), ::std::as_const(v).value());
-      return (keep ? type{::std::in_place, FWD(v).value()}
-                   : type{::fn::unexpect, ::fn::apply(FWD(on_err), FWD(v).value())});
+      if (keep)
+        return type{::std::in_place, FWD(v).value()};
+      return detail::_make_error<type>([&]() -> decltype(auto) { return ::fn::apply(FWD(on_err), FWD(v).value()); });
     }
     return FWD(v);
   }
@@ -124,8 +125,9 @@ struct filter_t::apply final {
     using type = ::std::remove_cvref_t<V>;
     if (::std::as_const(v).has_value()) {
       bool const keep = ::fn::apply(FWD(pred));
-      return (keep ? type{::std::in_place} //
-                   : type{::fn::unexpect, ::fn::apply(FWD(on_err))});
+      if (keep)
+        return type{::std::in_place};
+      return detail::_make_error<type>([&]() -> decltype(auto) { return ::fn::apply(FWD(on_err)); });
     }
     return FWD(v);
   }
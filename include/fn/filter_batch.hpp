@@ -0,0 +1,141 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_FILTER_BATCH
+#define INCLUDE_FN_FILTER_BATCH
+
+#include <fn/concepts.hpp>
+#include <fn/expected.hpp>
+#include <fn/functional.hpp>
+#include <fn/optional.hpp>
+#include <libfn_version.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+namespace detail {
+// The carriers of a batch are filtered where they are stored: a contiguous range of mutable lvalues
+template <typename R>
+concept _filter_batch_range
+    = ::std::ranges::contiguous_range<R> && ::std::ranges::sized_range<R>
+      && ::std::is_lvalue_reference_v<::std::ranges::range_reference_t<R>>
+      && (not ::std::is_const_v<::std::remove_reference_t<::std::ranges::range_reference_t<R>>>)
+      && (not some_identity<::std::ranges::range_value_t<R>>);
+
+// The number of elements whose predicate is evaluated before any of them is rebuilt: the mask fits
+// on the stack, and the loop filling it is free of the stores of the rebuild
+constexpr inline ::std::size_t _filter_batch_chunk = 256;
+
+// The predicate over a chunk, then the rejects of that chunk
+template <typename R, typename Pred, typename Reject>
+constexpr auto _filter_batch_run(R &range, Pred &pred, Reject const &reject) -> ::std::size_t
+{
+  constexpr auto chunk = _filter_batch_chunk;
+  auto *const first = ::std::ranges::data(range);
+  auto const size = static_cast<::std::size_t>(::std::ranges::size(range));
+  ::std::array<bool, chunk> keep{};
+  ::std::size_t rejected = 0;
+  for (::std::size_t base = 0; base < size; base += chunk) {
+    auto *const at = first + base;
+    auto const count = ::std::min(chunk, size - base);
+    for (::std::size_t i = 0; i < count; ++i)
+      keep[i] = not at[i].has_value() || static_cast<bool>(::fn::apply(pred, ::std::as_const(at[i]).value()));
+    for (::std::size_t i = 0; i < count; ++i) {
+      if (not keep[i]) {
+        reject(at[i]);
+        ++rejected;
+      }
+    }
+  }
+  return rejected;
+}
+} // namespace detail
+
+/**
+ * @brief Checks if the range of carriers can be filtered with `filter_batch`
+ *
+ * @tparam Pred The predicate to filter the values
+ * @tparam Err The error handler, `void` for a range of `optional`
+ * @tparam R The range of carriers
+ */
+template <typename Pred, typename Err, typename R>
+concept applicable_filter_batch //
+    = detail::_filter_batch_range<R>
+      && ((some_expected_non_void<::std::ranges::range_value_t<R>>
+           && requires(Pred &pred, Err &on_err, ::std::ranges::range_value_t<R> &v) {
+                { ::fn::apply(pred, ::std::as_const(v).value()) } -> convertible_to_bool;
+                {
+                  ::fn::apply(on_err, ::std::move(v).value())
+                } -> ::std::convertible_to<typename ::std::ranges::range_value_t<R>::error_type>;
+                requires ::std::is_move_assignable_v<::std::ranges::range_value_t<R>>;
+              })
+          || (some_optional<::std::ranges::range_value_t<R>> && ::std::same_as<Err, void>
+              && requires(Pred &pred, ::std::ranges::range_value_t<R> &v) {
+                   { ::fn::apply(pred, ::std::as_const(v).value()) } -> convertible_to_bool;
+                 }));
+
+/**
+ * @brief Filters a contiguous batch of carriers in place, in chunks
+ *
+ * The batch form of `filter`, over the carriers of a `std::span`, a `std::vector` or any other
+ * contiguous range of them. Rather than testing and rebuilding each carrier in turn, each chunk of
+ * the batch is visited twice: first the predicate is evaluated on every value held, into a mask,
+ * by a loop which does nothing else and which the compiler is free to vectorize; then only the
+ * carriers the mask rejects are rebuilt - an `expected` with the error the handler makes of the
+ * value, an `optional` empty. A carrier kept, or holding no value, is not touched at all.
+ *
+ * Use through the `fn::filter_batch` nielbloid.
+ */
+constexpr inline struct filter_batch_t final {
+  /**
+   * @brief Filters a batch of `expected`, replacing each value the predicate refuses by an error
+   *
+   * @param range The contiguous range of `expected`, filtered in place
+   * @param pred The predicate, applied on each value as const
+   * @param on_err The error handler, consuming each value refused
+   * @return The number of values refused
+   */
+  template <::std::ranges::contiguous_range R, typename Pred, typename OnErr>
+    requires applicable_filter_batch<Pred, OnErr, R>
+  constexpr auto operator()(R &&range, Pred &&pred, OnErr &&on_err) const -> ::std::size_t
+  {
+    using type = ::std::ranges::range_value_t<R>;
+    return detail::_filter_batch_run(range, pred, [&on_err](type &element) {
+      element = type{::fn::unexpect, ::fn::apply(on_err, ::std::move(element).value())};
+    });
+  }
+
+  /**
+   * @brief Filters a batch of `optional`, resetting each one whose value the predicate refuses
+   *
+   * @param range The contiguous range of `optional`, filtered in place
+   * @param pred The predicate, applied on each value as const
+   * @return The number of values refused
+   */
+  template <::std::ranges::contiguous_range R, typename Pred>
+    requires applicable_filter_batch<Pred, void, R>
+  constexpr auto operator()(R &&range, Pred &&pred) const -> ::std::size_t
+  {
+    using type = ::std::ranges::range_value_t<R>;
+    return detail::_filter_batch_run(range, pred, [](type &element) noexcept { element.reset(); });
+  }
+} filter_batch = {}; ///< Filters a contiguous batch of carriers in place: `filter_batch(span, pred, on_err)`
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_FILTER_BATCH
@@ -0,0 +1,147 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_FOLD_UNTIL
+#define INCLUDE_FN_FOLD_UNTIL
+
+#include <fn/expected.hpp>
+#include <fn/functional.hpp>
+#include <fn/optional.hpp>
+#include <libfn_version.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+namespace detail {
+// The step's carrier, rebound to hold the accumulator: an expected keeps its error type, an optional
+// only the empty state. A step returning anything else - a reference optional, a void expected, a
+// bare value - has nothing to fold and no type here.
+template <typename Acc, typename Res> struct _fold_result {};
+template <typename Acc, typename T, typename E> struct _fold_result<Acc, ::fn::expected<T, E>> {
+  using type = ::fn::expected<Acc, E>;
+};
+template <typename Acc, typename T>
+  requires(not ::std::is_reference_v<T>)
+struct _fold_result<Acc, ::fn::optional<T>> {
+  using type = ::fn::optional<Acc>;
+};
+
+template <typename Step, typename Acc, typename R>
+using _fold_step_t = ::std::remove_cvref_t<apply_result_t<Step &, Acc &&, ::std::ranges::range_reference_t<R>>>;
+
+template <typename R, typename Acc, typename Step>
+using _fold_result_t = typename _fold_result<Acc, _fold_step_t<Step, Acc, R>>::type;
+
+// Passing the failure on: an error is moved across, an empty state has nothing to move
+template <typename Res, typename Ret> constexpr inline bool _nothrow_fold_failure = true;
+template <typename Res, typename Ret>
+  requires _is_some_expected<Res &>
+constexpr inline bool _nothrow_fold_failure<Res, Ret>
+    = ::std::is_nothrow_constructible_v<Ret, ::fn::unexpect_t, decltype(::std::declval<Res>().error())>;
+
+template <typename R, typename Acc, typename Step>
+constexpr inline bool _nothrow_fold_until
+    = noexcept(::std::ranges::begin(::std::declval<R &>())) && noexcept(::std::ranges::end(::std::declval<R &>()))
+      && noexcept(++::std::declval<::std::ranges::iterator_t<R> &>())
+      && noexcept(*::std::declval<::std::ranges::iterator_t<R> &>())
+      && noexcept(::std::declval<::std::ranges::iterator_t<R> &>() != ::std::declval<::std::ranges::sentinel_t<R> &>())
+      && is_nothrow_applicable_v<Step &, Acc &&, ::std::ranges::range_reference_t<R>>
+      && ::std::is_nothrow_move_constructible_v<Acc>
+      && ::std::is_nothrow_assignable_v<Acc &, decltype(*::std::declval<_fold_step_t<Step, Acc, R>>())>
+      && ::std::is_nothrow_constructible_v<_fold_result_t<R, Acc, Step>, ::std::in_place_t, Acc &&>
+      && _nothrow_fold_failure<_fold_step_t<Step, Acc, R>, _fold_result_t<R, Acc, Step>>;
+} // namespace detail
+
+/**
+ * @brief Checks if `fold_until` can fold the range into the accumulator with the step
+ *
+ * The step is applied as `fn::apply` applies, to the accumulator as an rvalue and an element, and
+ * must return an `expected` with a non-void value or an `optional` over a non-reference, whose value
+ * is assigned back to the accumulator.
+ *
+ * @tparam R The range
+ * @tparam Acc The accumulator type
+ * @tparam Step The step
+ */
+template <typename R, typename Acc, typename Step>
+concept foldable_until                                                                                     //
+    = ::std::ranges::input_range<R> && ::std::is_move_constructible_v<Acc>                                 //
+      && applicable<Step &, Acc &&, ::std::ranges::range_reference_t<R>>                                   //
+      && requires { typename detail::_fold_result_t<R, Acc, Step>; }                                     //
+      && ::std::is_assignable_v<Acc &, decltype(*::std::declval<detail::_fold_step_t<Step, Acc, R>>())>;
+
+/**
+ * @brief A monadic left fold over a range, stopping at the first failure
+ *
+ * Each element is passed to the step together with the accumulator, moved in, and the value of the
+ * carrier it returns is moved back into the accumulator: the fold is a loop, its depth does not
+ * grow with the input, and no step copies the accumulator. The first failure ends the fold, the
+ * remaining elements unvisited, and is returned in place of the accumulator - the error of an
+ * `expected` as the step returned it, the empty state of an `optional`.
+ *
+ * Use through the `fn::fold_until` nielbloid.
+ */
+constexpr inline struct fold_until_t final {
+  /**
+   * @brief Folds the range into the accumulator, stopping at the first failure
+   *
+   * @param range The elements, visited in order
+   * @param init The initial accumulator
+   * @param step Takes the accumulator and an element, returns the next accumulator in a carrier
+   * @return The final accumulator in the step's carrier, or the first failure
+   */
+  template <::std::ranges::input_range R, typename Acc, typename Step>
+    requires foldable_until<R, Acc, Step>
+  [[nodiscard]] constexpr auto operator()(R &&range, Acc init, Step &&step) const
+      noexcept(detail::_nothrow_fold_until<R, Acc, Step>) -> detail::_fold_result_t<R, Acc, Step>
+  {
+    using result_t = detail::_fold_result_t<R, Acc, Step>;
+    for (auto &&element : range) {
+      auto next = ::fn::apply(step, ::std::move(init), FWD(element));
+      if (not next.has_value()) {
+        if constexpr (some_expected<result_t>)
+          return result_t(::fn::unexpect, ::std::move(next).error());
+        else
+          return result_t(::std::nullopt);
+      }
+      init = *::std::move(next);
+    }
+    return result_t(::std::in_place, ::std::move(init));
+  }
+
+  /**
+   * @brief Folds the range into a container accumulator, reserving its capacity first
+   *
+   * @param range The elements, visited in order
+   * @param init The initial accumulator, a container with `reserve`
+   * @param step Takes the accumulator and an element, returns the next accumulator in a carrier
+   * @param capacity The capacity reserved in the accumulator before the first step
+   * @return The final accumulator in the step's carrier, or the first failure
+   */
+  template <::std::ranges::input_range R, typename Acc, typename Step>
+    requires foldable_until<R, Acc, Step> && requires(Acc &acc, ::std::size_t n) { acc.reserve(n); }
+  [[nodiscard]] constexpr auto operator()(R &&range, Acc init, Step &&step, ::std::size_t capacity) const
+      noexcept(noexcept(init.reserve(capacity)) && detail::_nothrow_fold_until<R, Acc, Step>)
+          -> detail::_fold_result_t<R, Acc, Step>
+  {
+    init.reserve(capacity);
+    return (*this)(FWD(range), ::std::move(init), FWD(step));
+  }
+} fold_until = {}; ///< Folds a range with a fallible step: `fold_until(range, init, step)`
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_FOLD_UNTIL
@@ -14,11 +14,76 @@
 
 #include <concepts>
 #include <type_traits>
+#include <utility>
+
+// Tracing, and all it depends on, costs nothing to a program which does not ask for it
+#ifdef LIBFN_TRACE
+#include <fn/trace.hpp>
+#endif
 
 #include <fn/detail/macro_begin.hpp>
 
 namespace fn {
 inline namespace LIBFN_VERSION {
+template <typename Functor, typename... Args> struct functor;
+
+namespace detail {
+template <typename T> constexpr bool _is_some_functor = false;
+template <typename Functor, typename... Args>
+constexpr bool _is_some_functor<::fn::functor<Functor, Args...> &> = true;
+template <typename Functor, typename... Args>
+constexpr bool _is_some_functor<::fn::functor<Functor, Args...> const &> = true;
+} // namespace detail
+
+/**
+ * @brief Checks if the type is a pipeline step, i.e. a `functor`
+ *
+ * @tparam T The type to check, cv-ref qualified as deduced
+ */
+template <typename T>
+concept some_functor = detail::_is_some_functor<T &>;
+
+struct pipeline_t;
+
+namespace detail {
+// A composition contributes its steps, anything else contributes itself: the steps are stored as
+// any verb stores its arguments, so as_value_t being its own fixed point keeps a spliced step's
+// storage exactly as it was.
+template <typename T>
+constexpr auto _pipeline_steps(T &&t) noexcept(noexcept(::fn::pack<as_value_t<T>>{FWD(t)}))
+    -> ::fn::pack<as_value_t<T>>
+  requires(not ::std::same_as<typename ::std::remove_cvref_t<T>::functor_type, ::fn::pipeline_t>)
+{
+  return {FWD(t)};
+}
+template <typename T>
+constexpr auto _pipeline_steps(T &&t) noexcept -> decltype(auto)
+  requires ::std::same_as<typename ::std::remove_cvref_t<T>::functor_type, ::fn::pipeline_t>
+{
+  return (FWD(t).data);
+}
+
+template <typename T> struct _pipeline_of;
+template <typename... Ts> struct _pipeline_of<::fn::pack<Ts...>> {
+  using type = ::fn::functor<::fn::pipeline_t, Ts...>;
+};
+
+template <typename Lh, typename Rh>
+constexpr auto _compose(Lh &&lh, Rh &&rh) //
+    noexcept(noexcept(_pipeline_steps(FWD(lh)).append(_pipeline_steps(FWD(rh))))) ->
+    typename _pipeline_of<decltype(_pipeline_steps(FWD(lh)).append(_pipeline_steps(FWD(rh))))>::type
+{
+  return {_pipeline_steps(FWD(lh)).append(_pipeline_steps(FWD(rh)))};
+}
+
+template <typename T>
+constexpr auto _as_pipeline(T &&t) noexcept(noexcept(::std::remove_cvref_t<decltype(_pipeline_steps(FWD(t)))>{
+    _pipeline_steps(FWD(t))})) -> typename _pipeline_of<::std::remove_cvref_t<decltype(_pipeline_steps(FWD(t)))>>::type
+{
+  return {_pipeline_steps(FWD(t))};
+}
+} // namespace detail
+
 /**
  * @brief A pipeline step waiting for a carrier: the verb and its arguments as one value
  *
@@ -55,8 +120,189 @@ template <typename Functor, typename... Args> struct functor final {
     requires ::std::same_as<::std::remove_cvref_t<decltype(self)>, functor>
              && monadic_invocable<functor_type, decltype(v), Args...>
   {
+#ifdef LIBFN_TRACE
+    // The one point every verb's `apply` is reached through; constant evaluation is never traced
+    if (not ::std::is_constant_evaluated())
+      detail::_trace<functor_type>(v);
+#endif
     return data_t::_swap_invoke(FWD(self).data, functor_apply{}, FWD(v));
   }
+
+  /**
+   * @brief Composes two pipeline steps into one, before any carrier arrives
+   *
+   * @param lh The step to run first - this `functor`
+   * @param rh The step to run next
+   * @return A `functor` over `fn::pipeline_t`, holding the steps of both sides flat
+   */
+  [[nodiscard]] constexpr friend auto operator|(auto &&lh, auto &&rh) //
+      noexcept(noexcept(detail::_compose(FWD(lh), FWD(rh)))) -> decltype(detail::_compose(FWD(lh), FWD(rh)))
+    requires ::std::same_as<::std::remove_cvref_t<decltype(lh)>, functor> && some_functor<decltype(rh)>
+  {
+    return detail::_compose(FWD(lh), FWD(rh));
+  }
+};
+
+namespace detail {
+template <typename V, typename S> using _pipe_t = decltype(::std::declval<V>() | ::std::declval<S>());
+
+// The `vacuous` hook. A verb declares the carriers over which it is the identity with a member
+//
+//   template <typename V> static constexpr bool vacuous = ...;
+//
+// answering true for the carrier type `V` reaching the step - typically an error-side verb over a
+// carrier with no error channel, i.e. `some_identity<V>`. Such a step is not run at all: its callback
+// is never instantiated, and the operand is handed to the next step as it is, provided the run's
+// result stays the same. A verb which declares nothing is never skipped.
+template <typename V, typename S>
+concept _vacuous = some_functor<S> && requires {
+  requires ::std::remove_cvref_t<S>::functor_type::template vacuous<V>;
+};
+
+// Two adjacent steps fuse when their verb says how, and the fused step yields the very type of the
+// two steps run in turn - so the choice between them can never be observed in the result type.
+template <typename V, typename S1, typename S2>
+concept _fusible //
+    = some_functor<S1> && some_functor<S2>
+      && ::std::same_as<typename ::std::remove_cvref_t<S1>::functor_type,
+                        typename ::std::remove_cvref_t<S2>::functor_type>
+      && requires(S1 &&s1, S2 &&s2) {
+           typename ::std::remove_cvref_t<S1>::functor_type::fuse;
+           {
+             ::std::declval<V>()
+                 | typename ::std::remove_cvref_t<S1>::functor_type::fuse{}(FWD(s1), FWD(s2))
+           } -> ::std::same_as<_pipe_t<_pipe_t<V, S1>, S2>>;
+         };
+
+template <typename S1, typename S2>
+using _fuse_t = decltype(typename ::std::remove_cvref_t<S1>::functor_type::fuse{}(::std::declval<S1>(),
+                                                                                  ::std::declval<S2>()));
+
+// A step may hand back its operand by reference, and that operand can be a temporary of the run
+// itself: an rvalue reference result is returned by value instead, never left dangling.
+template <typename T> struct _pipeline_result {
+  using type = T;
+};
+template <typename T> struct _pipeline_result<T &&> {
+  using type = ::std::remove_cvref_t<T>;
+};
+
+// Steps are run one at a time, the result of each feeding the next; a chain in which any step does
+// not accept what its predecessor yields has no `type`, and the pipeline is then not applicable.
+template <typename V, typename... Ss> struct _pipeline {};
+template <typename V, typename... Ss>
+using _pipeline_result_t = typename _pipeline_result<typename _pipeline<V, Ss...>::type>::type;
+
+template <typename V, typename S>
+  requires requires { typename _pipe_t<V, S>; }
+struct _pipeline<V, S> {
+  using type = _pipe_t<V, S>;
+  static constexpr bool skip = _vacuous<V, S> && ::std::is_constructible_v<type, V>;
+  static constexpr bool nothrow = skip ? ::std::is_nothrow_constructible_v<type, V>
+                                       : noexcept(::std::declval<V>() | ::std::declval<S>());
+
+  static constexpr auto run(V &&v, [[maybe_unused]] S &&s) noexcept(nothrow) -> type
+  {
+    if constexpr (skip)
+      return FWD(v);
+    else
+      return FWD(v) | FWD(s);
+  }
+};
+
+template <typename V, typename S1, typename S2, typename... Ss>
+  requires requires { typename _pipeline<_pipe_t<V, S1>, S2, Ss...>::type; }
+struct _pipeline<V, S1, S2, Ss...> {
+  using type = _pipeline_result_t<_pipe_t<V, S1>, S2, Ss...>;
+  static constexpr bool skip = _vacuous<V, S1> && requires {
+    requires ::std::same_as<_pipeline_result_t<V, S2, Ss...>, type>;
+    requires ::std::is_constructible_v<type, typename _pipeline<V, S2, Ss...>::type>;
+  };
+
+  static constexpr bool _nothrow() noexcept
+  {
+    if constexpr (skip)
+      return ::std::is_nothrow_constructible_v<type, typename _pipeline<V, S2, Ss...>::type>
+             && _pipeline<V, S2, Ss...>::nothrow;
+    else if constexpr (not ::std::is_nothrow_constructible_v<type, typename _pipeline<_pipe_t<V, S1>, S2, Ss...>::type>)
+      return false;
+    else if constexpr (_fusible<V, S1, S2>)
+      return noexcept(typename ::std::remove_cvref_t<S1>::functor_type::fuse{}(::std::declval<S1>(),
+                                                                                ::std::declval<S2>()))
+             && _pipeline<V, _fuse_t<S1, S2>, Ss...>::nothrow;
+    else
+      return noexcept(::std::declval<V>() | ::std::declval<S1>()) && _pipeline<_pipe_t<V, S1>, S2, Ss...>::nothrow;
+  }
+  static constexpr bool nothrow = _nothrow();
+
+  static constexpr auto run(V &&v, [[maybe_unused]] S1 &&s1, S2 &&s2, Ss &&...ss) noexcept(nothrow) -> type
+  {
+    if constexpr (skip) {
+      return _pipeline<V, S2, Ss...>::run(FWD(v), FWD(s2), FWD(ss)...);
+    } else if constexpr (_fusible<V, S1, S2>) {
+      using fuse = typename ::std::remove_cvref_t<S1>::functor_type::fuse;
+      return _pipeline<V, _fuse_t<S1, S2>, Ss...>::run(FWD(v), fuse{}(FWD(s1), FWD(s2)), FWD(ss)...);
+    } else {
+      return _pipeline<_pipe_t<V, S1>, S2, Ss...>::run(FWD(v) | FWD(s1), FWD(s2), FWD(ss)...);
+    }
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief A reusable pipeline: a run of steps composed once, applied left to right
+ *
+ * What `fn::pipeline(steps...)` and composing two steps with `operator|` return is a `functor`
+ * over this verb, holding the steps flat - composing a composition splices it rather than nesting
+ * it. The run is resolved per carrier type, at compile time, once for all carriers of that type:
+ *
+ * - adjacent steps of a verb which declares a nested `fuse` are fused into one step, as long as
+ *   the fused step yields exactly the type the two steps would have yielded one after the other;
+ *   `fn::transform` fuses `transform(f) | transform(g)` into one call of `g(f(v))`, leaving no
+ *   intermediate carrier
+ * - a step whose verb declares itself `vacuous` over the carrier reaching it is not run: an
+ *   error-side step behind a step which cannot fail, such as one yielding `expected<T, copack<>>`,
+ *   is dropped along with its callback
+ *
+ * Use through the `fn::pipeline` nielbloid, or by composing steps with `operator|`.
+ */
+constexpr inline struct pipeline_t final {
+  /**
+   * @brief Composes pipeline steps into one reusable step
+   *
+   * @param steps The steps to run, left to right; a composed pipeline contributes its own steps
+   * @return A `functor` over `fn::pipeline_t`, holding the steps flat
+   */
+  template <some_functor S, some_functor... Ss>
+  [[nodiscard]] constexpr auto operator()(S &&step, Ss &&...steps) const
+      noexcept(noexcept((detail::_as_pipeline(FWD(step)) | ... | FWD(steps))))
+          -> decltype((detail::_as_pipeline(FWD(step)) | ... | FWD(steps)))
+  {
+    return (detail::_as_pipeline(FWD(step)) | ... | FWD(steps));
+  }
+
+  struct apply;
+} pipeline = {}; ///< Composes steps into one reusable step: `x | pipeline(and_then(f), transform(g))`
+
+struct pipeline_t::apply final {
+  /**
+   * @brief Runs the steps of a pipeline, left to right, fusing and skipping where the verbs allow
+   *
+   * @param v The monad
+   * @param steps The steps to run
+   * @return Whatever the last step returns, by value if that is an rvalue reference
+   */
+  template <some_monadic_type V, typename... Ss>
+  [[nodiscard]] constexpr auto operator()(V &&v, Ss &&...steps) const
+      noexcept(detail::_pipeline<V &&, Ss &&...>::nothrow
+               && ::std::is_nothrow_constructible_v<detail::_pipeline_result_t<V &&, Ss &&...>,
+                                                    typename detail::_pipeline<V &&, Ss &&...>::type>)
+          -> detail::_pipeline_result_t<V &&, Ss &&...>
+    requires requires { typename detail::_pipeline<V &&, Ss &&...>::type; }
+  {
+    return detail::_pipeline<V &&, Ss &&...>::run(FWD(v), FWD(steps)...);
+  }
 };
 
 } // namespace LIBFN_VERSION
@@ -0,0 +1,150 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_INSPECT_AT
+#define INCLUDE_FN_INSPECT_AT
+
+#include <fn/concepts.hpp>
+#include <fn/functor.hpp>
+#include <fn/inspect.hpp>
+#include <fn/inspect_error.hpp>
+#include <libfn_version.hpp>
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+#include <fn/detail/macro_begin.hpp>
+
+// The lowest level of `inspect_at` and `inspect_error_at` compiled in; every step below it is the
+// identity. Chosen for a whole program, as LIBFN_TRACE is.
+#ifndef LIBFN_INSPECT_LEVEL
+#define LIBFN_INSPECT_LEVEL 0
+#endif
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+/**
+ * @brief The lowest level of `inspect_at` and `inspect_error_at` compiled in, `LIBFN_INSPECT_LEVEL`
+ */
+constexpr inline unsigned inspect_level = LIBFN_INSPECT_LEVEL;
+
+namespace detail {
+// The wrapped verb's own vacuity, where it declares one
+template <typename Verb, typename V> constexpr inline bool _inspect_vacuous = false;
+template <typename Verb, typename V>
+  requires requires { requires Verb::template vacuous<V>; }
+constexpr inline bool _inspect_vacuous<Verb, V> = true;
+} // namespace detail
+
+/**
+ * @brief An `inspect` or `inspect_error` step kept in the code at a diagnostic level
+ *
+ * At or above `fn::inspect_level` the step is the wrapped verb's own: the same functor as
+ * `fn::inspect(fn)` or `fn::inspect_error(fn)`, or, given an atomic flag as well, that verb run only
+ * while a relaxed load of the flag answers `true`. Below it the step is the identity: the callback
+ * is not stored - a step carries no state, whatever the callback captured - nor instantiated, the
+ * operand is returned as it came, and a `fn::pipeline` does not run the step at all.
+ *
+ * Use through the `fn::inspect_at` and `fn::inspect_error_at` nielbloids.
+ *
+ * @tparam Level The level of the step
+ * @tparam Verb The wrapped verb, `fn::inspect_t` or `fn::inspect_error_t`
+ */
+template <unsigned Level, typename Verb> struct inspect_at_t final {
+  /**
+   * @brief Whether the step is compiled in
+   */
+  static constexpr bool enabled = Level >= inspect_level;
+
+  /**
+   * @brief Observe the carrier, if the level is compiled in
+   * @param fn The function to observe the value, or the error
+   * @return The wrapped verb's functor, or one which returns the operand as it is
+   */
+  [[nodiscard]] constexpr auto operator()([[maybe_unused]] auto &&fn) const
+      noexcept(not enabled || noexcept(Verb{}(FWD(fn)))) -> decltype(auto)
+  {
+    if constexpr (enabled)
+      return Verb{}(FWD(fn));
+    else
+      return functor<inspect_at_t>{};
+  }
+
+  /**
+   * @brief Observe the carrier while the flag is set, if the level is compiled in
+   * @param flag The flag, loaded with relaxed ordering each time a carrier arrives
+   * @param fn The function to observe the value, or the error
+   * @return A functor running the wrapped verb while the flag is set, or one which returns the
+   *         operand as it is
+   */
+  [[nodiscard]] constexpr auto operator()([[maybe_unused]] ::std::atomic<bool> const &flag,
+                                          [[maybe_unused]] auto &&fn) const
+      noexcept(not enabled || noexcept(functor<inspect_at_t, ::std::atomic<bool> const &, decltype(fn)>{flag, FWD(fn)}))
+          -> decltype(auto)
+  {
+    if constexpr (enabled)
+      return functor<inspect_at_t, ::std::atomic<bool> const &, decltype(fn)>{flag, FWD(fn)};
+    else
+      return functor<inspect_at_t>{};
+  }
+
+  template <typename V> static constexpr bool vacuous = (not enabled) || detail::_inspect_vacuous<Verb, V>;
+
+  struct apply;
+};
+
+template <unsigned Level, typename Verb> struct inspect_at_t<Level, Verb>::apply final {
+  /**
+   * @brief Returns the operand as it is: the step below the level compiled in
+   *
+   * @param v The monad
+   * @return The operand, forwarded unchanged
+   */
+  template <some_monadic_type V> [[nodiscard]] constexpr auto operator()(V &&v) const noexcept -> V &&
+  {
+    return FWD(v);
+  }
+
+  /**
+   * @brief Runs the wrapped verb while the flag is set
+   *
+   * @param v The monad
+   * @param flag The flag
+   * @param fn The function to observe the value, or the error
+   * @return The operand, forwarded unchanged
+   */
+  template <some_monadic_type V, typename Fn>
+  [[nodiscard]] constexpr auto operator()(V &&v, ::std::atomic<bool> const &flag, Fn &&fn) const
+      noexcept(noexcept(typename Verb::apply{}(FWD(v), FWD(fn)))) -> V &&
+    requires ::std::is_invocable_r_v<V &&, typename Verb::apply const &, V &&, Fn &&>
+  {
+    if (flag.load(::std::memory_order_relaxed))
+      return typename Verb::apply{}(FWD(v), FWD(fn));
+    return FWD(v);
+  }
+};
+
+/**
+ * @brief Observes the value at a diagnostic level: `x | inspect_at<Level>(f)`
+ *
+ * @tparam Level The level of the step, compiled out below `fn::inspect_level`
+ */
+template <unsigned Level> constexpr inline inspect_at_t<Level, inspect_t> inspect_at = {};
+
+/**
+ * @brief Observes the error at a diagnostic level: `x | inspect_error_at<Level>(f)`
+ *
+ * @tparam Level The level of the step, compiled out below `fn::inspect_level`
+ */
+template <unsigned Level> constexpr inline inspect_at_t<Level, inspect_error_t> inspect_error_at = {};
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_INSPECT_AT
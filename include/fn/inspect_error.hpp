@@ -53,6 +53,9 @@ constexpr inline struct inspect_error_t final {
     return {FWD(fn)};
   }
 
+  // No error to observe on the identity cluster: skipped in a pipeline, see detail::_vacuous
+  template <typename V> static constexpr bool vacuous = some_identity<V>;
+
   struct apply;
 } inspect_error = {}; ///< Observes the error in passing: `x | inspect_error(f)`
 
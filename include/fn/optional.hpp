@@ -12,12 +12,15 @@
 
 #include <fn/copack.hpp>
 #include <fn/detail/functional.hpp>
+#include <fn/detail/uses_allocator.hpp>
 #include <fn/fwd.hpp>
+#include <fn/optional_niche.hpp>
 #include <fn/pack.hpp>
 
 #include <compare>
 #include <functional>
 #include <initializer_list>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -36,6 +39,8 @@ concept some_optional = detail::_some_optional<T>;
 
 namespace detail {
 
+template <class T> struct _optional_niche_base;
+
 // [optional.iterators]: the implementation-defined iterator types for fn::optional. A
 // minimal wrapper over T* whose job is to keep pointer-ness out of optional interface.
 template <class T> class _optional_iterator {
@@ -46,6 +51,7 @@ template <class T> class _optional_iterator {
   // Only an optional's base mints iterators from storage pointers; the sibling friendship
   // lets the iterator -> const_iterator converting constructor read p_.
   template <class, class> friend struct ::pfn::detail::_optional_base;
+  template <class> friend struct _optional_niche_base;
   template <class> friend class _optional_iterator;
 
   constexpr explicit _optional_iterator(T *p) noexcept : p_(p) {}
@@ -207,9 +213,224 @@ struct _nothrow_optional_and_then<Fn, V> {
   static constexpr bool value = _is_nothrow_rts_applicable<typename _optional_and_then_dispatch<Fn, V>::type, Fn, V>;
 };
 
+// Storage of an fn::optional<T> whose T declares a niche in ::fn::optional_niche: in place of
+// pfn's union and `bool set_`, a T lives in either state and the niche's sentinel stands for the
+// empty one - as pfn's optional<T&> lets nullptr stand for it. The constraints are pfn's, and every
+// operation keeps the semantics of pfn's; what differs is only how the state is read and changed.
+// T is trivially copyable, so the special members are trivial, and a change of state is a
+// construction over the T in hand, which needs no destruction first.
+template <class T> struct _optional_niche_base {
+  using _niche = ::fn::optional_niche<T>;
+  using _value_t = T;
+  // The pfn base is named for its constraints only, and never instantiated as an object
+  using _constraints = ::pfn::detail::_optional_base<T, optional_policy>;
+  T v_;
+
+  template <class U> using _can_convert = typename _constraints::template _can_convert<U>;
+  template <class U> using _can_assign = typename _constraints::template _can_assign<U>;
+  template <class U> using _can_copy_convert = typename _constraints::template _can_copy_convert<U>;
+  template <class U> using _can_move_convert = typename _constraints::template _can_move_convert<U>;
+  template <class U> using _can_copy_assign = typename _constraints::template _can_copy_assign<U>;
+  template <class U> using _can_move_assign = typename _constraints::template _can_move_assign<U>;
+
+  template <class... Args>
+  constexpr explicit _optional_niche_base(::std::in_place_t /*ignored*/, Args &&...a) //
+      noexcept(::std::is_nothrow_constructible_v<T, Args...>)
+    requires ::std::is_constructible_v<T, Args...>
+      : v_(FWD(a)...)
+  {
+  }
+  template <class U, class... Args>
+  constexpr explicit _optional_niche_base(::std::in_place_t /*ignored*/, ::std::initializer_list<U> il,
+                                          Args &&...a) //
+      noexcept(::std::is_nothrow_constructible_v<T, ::std::initializer_list<U> &, Args...>)
+    requires ::std::is_constructible_v<T, ::std::initializer_list<U> &, Args...>
+      : v_(il, FWD(a)...)
+  {
+  }
+  template <typename Fn, typename... Args>
+  constexpr explicit _optional_niche_base(::pfn::detail::_optional_from_invoke_t /*ignored*/, Fn &&fn,
+                                          Args &&...args) //
+      noexcept(::std::is_nothrow_invocable_v<Fn, Args...>
+               && (::std::is_same_v<::std::remove_cv_t<::std::invoke_result_t<Fn, Args...>>, ::std::remove_cv_t<T>>
+                   || ::std::is_nothrow_constructible_v<T, ::std::invoke_result_t<Fn, Args...>>))
+      : v_(::std::invoke(FWD(fn), FWD(args)...))
+  {
+  }
+  constexpr explicit _optional_niche_base(::std::nullopt_t /*ignored*/) noexcept : v_(_niche::empty()) {}
+
+  // [optional.ctor], converting constructors from a differently-typed optional<U>, read through
+  // its public has_value()/operator*() as pfn's _from_optional_t constructor reads it
+  template <class U>
+  constexpr explicit(not ::std::is_convertible_v<U const &, T>)
+      _optional_niche_base(::fn::optional<U> const &s)      //
+      noexcept(::std::is_nothrow_constructible_v<T, U const &>) // extension
+    requires(_can_copy_convert<U>::value)
+      : v_(s.has_value() ? T(*s) : _niche::empty())
+  {
+  }
+  template <class U>
+  constexpr explicit(not ::std::is_convertible_v<U, T>) _optional_niche_base(::fn::optional<U> &&s) //
+      noexcept(::std::is_nothrow_constructible_v<T, U>)                                           // extension
+    requires(_can_move_convert<U>::value)
+      : v_(s.has_value() ? T(*::std::move(s)) : _niche::empty())
+  {
+  }
+
+  constexpr _optional_niche_base(_optional_niche_base const &) noexcept = default;
+  constexpr _optional_niche_base(_optional_niche_base &&) noexcept = default;
+  constexpr _optional_niche_base &operator=(_optional_niche_base const &) noexcept = default;
+  constexpr _optional_niche_base &operator=(_optional_niche_base &&) noexcept = default;
+  constexpr ~_optional_niche_base() = default;
+
+  // Constructs the value over the T in hand, which is the sentinel while the optional is empty. A
+  // constructor which throws may leave any bytes behind, so the sentinel is restored: the optional
+  // is empty after a failed engagement, as [optional.assign] has it.
+  template <class... Args> constexpr T &_engage(Args &&...args)
+  {
+    if constexpr (::std::is_nothrow_constructible_v<T, Args...>) {
+      ::std::construct_at(::std::addressof(v_), FWD(args)...);
+    } else {
+      try {
+        ::std::construct_at(::std::addressof(v_), FWD(args)...);
+      } catch (...) {
+        ::std::construct_at(::std::addressof(v_), _niche::empty());
+        throw;
+      }
+    }
+    return v_;
+  }
+
+  // [optional.mod] reset; also the disengage step of operator=(nullopt_t) and emplace
+  constexpr void reset() noexcept { ::std::construct_at(::std::addressof(v_), _niche::empty()); }
+
+  constexpr void _assign(auto &&s)
+  {
+    if (has_value() && s.has_value())
+      v_ = FWD(s).v_;
+    else if (s.has_value())
+      _engage(FWD(s).v_);
+    else
+      reset();
+  }
+
+  template <class U> constexpr void _assign_value(U &&s)
+  {
+    if (has_value())
+      v_ = FWD(s);
+    else
+      _engage(FWD(s));
+  }
+
+  template <typename S> constexpr void _assign_from(S &&s)
+  {
+    if (has_value() && s.has_value())
+      v_ = *FWD(s);
+    else if (s.has_value())
+      _engage(*FWD(s));
+    else
+      reset();
+  }
+
+  constexpr void _swap_with(_optional_niche_base &rhs)
+  {
+    if (has_value() && rhs.has_value()) {
+      using ::std::swap;
+      swap(v_, rhs.v_);
+    } else if (has_value()) {
+      rhs._engage(::std::move(v_));
+      reset();
+    } else if (rhs.has_value()) {
+      rhs._swap_with(*this);
+    }
+    // else: both disengaged, no effect
+  }
+
+  template <class... Args>
+  constexpr T &emplace(Args &&...args) //
+    requires ::std::is_constructible_v<T, Args...>
+  {
+    reset();
+    return _engage(FWD(args)...);
+  }
+  template <class U, class... Args>
+  constexpr T &emplace(::std::initializer_list<U> il, Args &&...args) //
+    requires ::std::is_constructible_v<T, ::std::initializer_list<U> &, Args...>
+  {
+    reset();
+    return _engage(il, FWD(args)...);
+  }
+
+  // [optional.iterators], as in pfn's base
+  using iterator = typename optional_policy::template iterator<T>;
+  using const_iterator = typename optional_policy::template iterator<T const>;
+  [[nodiscard]] constexpr iterator begin() noexcept
+  {
+    return iterator(has_value() ? ::std::addressof(v_) : nullptr);
+  }
+  [[nodiscard]] constexpr const_iterator begin() const noexcept
+  {
+    return const_iterator(has_value() ? ::std::addressof(v_) : nullptr);
+  }
+  [[nodiscard]] constexpr iterator end() noexcept { return begin() + has_value(); }
+  [[nodiscard]] constexpr const_iterator end() const noexcept { return begin() + has_value(); }
+
+  // [optional.observe], observers
+  constexpr T const *operator->() const noexcept { return ::std::addressof(v_); }
+  constexpr T *operator->() noexcept { return ::std::addressof(v_); }
+  constexpr T const &operator*() const & noexcept { return v_; }
+  constexpr T &operator*() & noexcept { return v_; }
+  constexpr T const &&operator*() const && noexcept { return ::std::move(v_); }
+  constexpr T &&operator*() && noexcept { return ::std::move(v_); }
+  constexpr explicit operator bool() const noexcept { return has_value(); }
+  constexpr bool has_value() const noexcept { return not _niche::is_empty(v_); }
+
+  constexpr T const &value() const &
+  {
+    if (not has_value())
+      throw ::std::bad_optional_access();
+    return v_;
+  }
+  constexpr T &value() &
+  {
+    if (not has_value())
+      throw ::std::bad_optional_access();
+    return v_;
+  }
+  constexpr T const &&value() const &&
+  {
+    if (not has_value())
+      throw ::std::bad_optional_access();
+    return ::std::move(v_);
+  }
+  constexpr T &&value() &&
+  {
+    if (not has_value())
+      throw ::std::bad_optional_access();
+    return ::std::move(v_);
+  }
+
+  template <class U = ::std::remove_cv_t<T>> constexpr T value_or(U &&v) const &
+  {
+    static_assert(::std::is_copy_constructible_v<T> && ::std::is_convertible_v<U &&, T>);
+    return has_value() ? v_ : static_cast<T>(::std::forward<U>(v));
+  }
+  template <class U = ::std::remove_cv_t<T>> constexpr T value_or(U &&v) &&
+  {
+    static_assert(::std::is_move_constructible_v<T> && ::std::is_convertible_v<U &&, T>);
+    return has_value() ? ::std::move(v_) : static_cast<T>(::std::forward<U>(v));
+  }
+};
+
+// The storage of an fn::optional<T>: pfn's, unless T declares a niche
+template <typename T>
+using _optional_storage_t = ::std::conditional_t<_has_optional_niche<T>, _optional_niche_base<T>,
+                                                 ::pfn::detail::_optional_base<T, optional_policy>>;
+
 // Storage layer for ::fn::optional. Inherits the standard-conformant base from
-// pfn, then hides the three monadic static helpers with copack-aware variants that
-// materialise their result via `optional_policy::template type<U>`.
+// pfn (or the niche storage above, with the same interface), then hides the three
+// monadic static helpers with copack-aware variants that materialise their result
+// via `optional_policy::template type<U>`.
 // The transform helpers hand pfn's _optional_from_invoke constructor a zero-argument
 // thunk, so the result's contained value is direct-non-list-initialized from fn's own
 // _apply (or copack::transform) result: no extra move, and immovable result types work.
@@ -217,9 +438,19 @@ struct _nothrow_optional_and_then<Fn, V> {
 // the callback of a copack/pack dispatch is invoked through `_apply`, not called directly, so it is
 // `_is_nothrow_applicable` - not the std trait, which is false for a callable that is not directly
 // applicable on a copack or a pack - that answers for it.
-template <typename T> struct _optional_base : ::pfn::detail::_optional_base<T, optional_policy> {
+template <typename T> struct _optional_base : _optional_storage_t<T> {
   using _pfn_base = ::pfn::detail::_optional_base<T, optional_policy>;
-  using _pfn_base::_pfn_base;
+  using _storage_base = _optional_storage_t<T>;
+  using _storage_base::_storage_base;
+
+  // An optional of this type, its value direct-non-list-initialized from the thunk's result; for the
+  // verbs which are not members, such as value_or_else
+  template <typename Fn>
+  [[nodiscard]] static constexpr auto _value_from_invoke(Fn &&fn) //
+      noexcept(noexcept(::fn::optional<T>(::pfn::detail::_optional_from_invoke, FWD(fn)))) -> ::fn::optional<T>
+  {
+    return ::fn::optional<T>(::pfn::detail::_optional_from_invoke, FWD(fn));
+  }
 
   // and_then
   template <typename Self, typename Fn>
@@ -598,6 +829,51 @@ public:
   {
   }
 
+  // Uses-allocator construction, as `std::uses_allocator` reports this carrier capable of: the
+  // allocator is passed on to the value constructed, where it takes one.
+  /**
+   * @brief Constructs the empty state; the allocator is unused
+   */
+  template <class Alloc> constexpr optional(::std::allocator_arg_t, Alloc const &) noexcept : _base(::std::nullopt) {}
+  template <class Alloc>
+  constexpr optional(::std::allocator_arg_t, Alloc const &, ::std::nullopt_t) noexcept : _base(::std::nullopt)
+  {
+  }
+  /**
+   * @brief Constructs the value in place from the arguments, passing the allocator on to it
+   */
+  template <class Alloc, class... Args>
+  constexpr explicit optional(::std::allocator_arg_t, Alloc const &a, ::std::in_place_t, Args &&...args)
+    requires requires { detail::_make_using_allocator<T>(a, FWD(args)...); }
+      : _base(::pfn::detail::_optional_from_invoke,
+              [&]() -> T { return detail::_make_using_allocator<T>(a, FWD(args)...); })
+  {
+  }
+  /**
+   * @brief Constructs the value from a value, passing the allocator on to it
+   */
+  template <class Alloc, class U = ::std::remove_cv_t<T>>
+  constexpr explicit(not ::std::is_convertible_v<U, T>) optional(::std::allocator_arg_t, Alloc const &a, U &&v)
+    requires(_base::template _can_convert<U>::value) && requires { detail::_make_using_allocator<T>(a, FWD(v)); }
+      : optional(::std::allocator_arg, a, ::std::in_place, FWD(v))
+  {
+  }
+  /**
+   * @brief Copies or moves a carrier, passing the allocator on to the value
+   */
+  template <class Alloc, class U>
+  constexpr optional(::std::allocator_arg_t, Alloc const &a, optional<U> const &s)
+    requires requires { detail::_make_using_allocator<T>(a, *s); }
+      : optional(s.has_value() ? optional(::std::allocator_arg, a, ::std::in_place, *s) : optional())
+  {
+  }
+  template <class Alloc, class U>
+  constexpr optional(::std::allocator_arg_t, Alloc const &a, optional<U> &&s)
+    requires requires { detail::_make_using_allocator<T>(a, *::std::move(s)); }
+      : optional(s.has_value() ? optional(::std::allocator_arg, a, ::std::in_place, *::std::move(s)) : optional())
+  {
+  }
+
   /**
    * @brief Copy constructor; not available on this carrier
    */
@@ -1839,6 +2115,10 @@ namespace std {
 // is enabled, hence never for reference types)
 template <class T> struct hash<::fn::optional<T>> : ::pfn::detail::_optional_hash_base<::fn::optional<T>, T> {};
 
+// Uses-allocator construction of an optional passes the allocator on to the value
+template <class T, class Alloc>
+struct uses_allocator<::fn::optional<T>, Alloc> : ::std::bool_constant<::fn::detail::_uses_allocator<T, Alloc>> {};
+
 #if defined(__cpp_lib_format_ranges)
 // range-format opt-out, mirroring pfn's [optional.syn] specialization
 template <class T> constexpr range_format format_kind<::fn::optional<T>> = range_format::disabled;
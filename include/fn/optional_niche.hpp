@@ -0,0 +1,125 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_OPTIONAL_NICHE
+#define INCLUDE_FN_OPTIONAL_NICHE
+
+#include <fn/copack.hpp>
+#include <fn/detail/meta.hpp>
+#include <fn/detail/variadic_union.hpp>
+#include <libfn_version.hpp>
+
+#include <concepts>
+#include <type_traits>
+#include <utility>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+/**
+ * @brief Customization point: a representation of `T` which `fn::optional<T>` keeps for its empty state
+ *
+ * The primary template declares no niche, and `fn::optional<T>` adds an engaged flag next to the
+ * value. A specialization declares the niche with two static members: `empty()`, making the
+ * sentinel `T`, and `is_empty(v)`, recognizing it, both `noexcept`. `fn::optional<T>` then holds a
+ * `T` in either state, the sentinel standing for the empty one, and is exactly as large as `T`.
+ *
+ * A niche is honoured for a trivially copyable `T` only, and must be declared before
+ * `fn::optional<T>` is first instantiated. The sentinel is not a value the optional can hold: one
+ * stored in it reads back as the empty state. No niche is declared by the library itself: each
+ * changes the layout of an `fn::optional<T>` which may already cross an ABI boundary.
+ *
+ * `std::string_view` has no niche to declare: every pair of pointer and length it can portably hold
+ * is a valid view, and making one which is not breaks the preconditions of its constructors.
+ *
+ * @tparam T The value type of the optional
+ */
+template <typename T> struct optional_niche {};
+
+/**
+ * @brief A niche in one value of the type, such as an enumerator declared for the purpose
+ *
+ * `template <> struct fn::optional_niche<Color> : fn::optional_sentinel<Color::none> {};`
+ *
+ * @tparam Sentinel The value standing for the empty state
+ */
+template <auto Sentinel> struct optional_sentinel {
+  /**
+   * @brief Makes the sentinel
+   */
+  [[nodiscard]] static constexpr auto empty() noexcept -> decltype(Sentinel) { return Sentinel; }
+
+  /**
+   * @brief Checks if the value is the sentinel
+   *
+   * @param v The value to check
+   */
+  [[nodiscard]] static constexpr bool is_empty(decltype(Sentinel) const &v) noexcept { return v == Sentinel; }
+};
+
+/**
+ * @brief A niche for a trivially copyable `copack`, to opt into: the index one past its last alternative
+ *
+ * `template <> struct fn::optional_niche<E> : fn::optional_copack_niche<E> {};`
+ *
+ * The sentinel holds the first alternative, value-initialized, under an index no alternative
+ * uses, which the copack's own operations never see: `fn::optional` does not expose it. It is not
+ * declared for every copack, as it changes the size and layout of `fn::optional` of one - which
+ * must then be the same in every translation unit.
+ *
+ * @tparam T The copack
+ */
+template <typename T> struct optional_copack_niche;
+
+template <typename... Ts>
+  requires(sizeof...(Ts) > 0) && ::std::is_trivially_copyable_v<copack<Ts...>>
+          && detail::_nothrow_makeable<typename copack<Ts...>::data_t, detail::select_nth_t<0, Ts...>>
+struct optional_copack_niche<copack<Ts...>> {
+  /**
+   * @brief Makes the sentinel
+   */
+  [[nodiscard]] static constexpr auto empty() noexcept -> copack<Ts...>
+  {
+    copack<Ts...> ret{::std::in_place_type<detail::select_nth_t<0, Ts...>>};
+    ret.index = copack<Ts...>::size;
+    return ret;
+  }
+
+  /**
+   * @brief Checks if the copack is the sentinel
+   *
+   * @param v The copack to check
+   */
+  [[nodiscard]] static constexpr bool is_empty(copack<Ts...> const &v) noexcept
+  {
+    return v.index == copack<Ts...>::size;
+  }
+};
+
+namespace detail {
+template <typename T>
+concept _has_optional_niche = ::std::is_object_v<T> && ::std::is_trivially_copyable_v<T> //
+                              && requires(T const &v) {
+                                   { ::fn::optional_niche<T>::empty() } noexcept -> ::std::same_as<T>;
+                                   { ::fn::optional_niche<T>::is_empty(v) } noexcept -> ::std::same_as<bool>;
+                                 };
+} // namespace detail
+
+/**
+ * @brief Checks if `fn::optional<T>` keeps its empty state in a niche of `T`
+ *
+ * @tparam T The value type of the optional
+ */
+template <typename T>
+concept has_optional_niche = detail::_has_optional_niche<T>;
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_OPTIONAL_NICHE
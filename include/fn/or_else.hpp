@@ -172,6 +172,9 @@ constexpr inline struct or_else_t final {
     return {FWD(fn)};
   }
 
+  // No dead state to bind on the identity cluster: skipped in a pipeline, see detail::_vacuous
+  template <typename V> static constexpr bool vacuous = some_identity<V>;
+
   struct apply;
 } or_else = {}; ///< Binds the dead state, returning a carrier: `x | or_else(f)`
 
@@ -389,6 +389,12 @@ template <typename Type, typename Side> struct _nothrow_disj_inject<false, Type,
       = _nothrow_initializable<Type, ::std::in_place_t, decltype(::std::declval<Side>().value())>;
 };
 
+#if defined(__GNUC__) && not defined(__clang__)
+// As for make_variadic_union: gcc 12-14 report the bytes of the value which a narrower error
+// leaves inactive as maybe-uninitialized, when the result is copied whole.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
 template <template <typename> typename Tpl>
 [[nodiscard]] constexpr auto _join(auto &&lh, auto &&rh, auto &&efn) //
     noexcept(_nothrow_join<Tpl, decltype(lh), decltype(rh), decltype(efn)>)
@@ -411,6 +417,9 @@ template <template <typename> typename Tpl>
       return type{efn(FWD(rh))};
   }
 }
+#if defined(__GNUC__) && not defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
 
 } // namespace detail
 
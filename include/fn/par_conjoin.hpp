@@ -0,0 +1,253 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_PAR_CONJOIN
+#define INCLUDE_FN_PAR_CONJOIN
+
+#include <fn/cancel_token.hpp>
+#include <fn/expected.hpp>
+#include <fn/monadic.hpp>
+#include <fn/optional.hpp>
+#include <fn/thread_pool.hpp>
+#include <libfn_version.hpp>
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+namespace detail {
+template <typename F> constexpr auto _invoke_task(F &f, cancel_token token) -> decltype(auto)
+{
+  if constexpr (::std::invocable<F &, cancel_token>)
+    return ::std::invoke(f, token);
+  else
+    return ::std::invoke(f);
+}
+
+template <typename F>
+using _task_result_t = ::std::remove_cvref_t<decltype(_invoke_task(::std::declval<F &>(), cancel_token{}))>;
+
+template <typename F>
+concept _par_task = (::std::invocable<F &, cancel_token> || ::std::invocable<F &>)
+                    && some_monadic_type<_task_result_t<F>> && ::std::is_move_constructible_v<_task_result_t<F>>;
+
+template <typename... Ts> using _par_conjoin_result_t = ::std::remove_cvref_t<decltype((... & ::std::declval<Ts>()))>;
+
+// The failure of one task, as the conjunction of all would carry it: its error widened into the
+// error of the whole, or the empty state.
+template <typename R, typename T>
+concept _par_failure_into = (some_expected<R> && some_expected<T>
+                             && ::std::is_constructible_v<R, ::fn::unexpect_t, decltype(::std::declval<T>().error())>)
+                            || (some_optional<R> && some_optional<T>);
+
+#if defined(__GNUC__) && not defined(__clang__)
+// As for _join: gcc 12-14 report the bytes of the value which a narrower error
+// leaves inactive as maybe-uninitialized, when the result is copied whole.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+template <typename R, typename T> constexpr auto _par_failure(T &&failed) -> R
+{
+  if constexpr (some_expected<R>)
+    return R(::fn::unexpect, FWD(failed).error());
+  else
+    return R(::std::nullopt);
+}
+#if defined(__GNUC__) && not defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+// Which tasks are taken up, by a worker of the executor or by the calling thread: each runs once, on
+// whichever takes it first. The caller takes up what no worker has started rather than wait for it -
+// called from a worker of that very executor, it would otherwise wait on its own queue.
+template <::std::size_t N> struct _par_claims final {
+  ::std::array<::std::atomic<bool>, N> taken = {};
+
+  [[nodiscard]] auto claim(::std::size_t index) noexcept -> bool
+  {
+    return not taken[index].exchange(true, ::std::memory_order_acq_rel);
+  }
+};
+
+// The tasks of par_conjoin handed to the executor, owned by them and by the caller: a task the caller
+// took up is still queued, and must find the claim once the call has returned. Only a task claimed by
+// a worker touches the caller's frame, which lives until every such task is complete.
+template <::std::size_t N> struct _par_join final {
+  _par_claims<N> claims = {};
+  ::std::mutex mutex = {};
+  ::std::condition_variable done = {};
+  ::std::size_t remaining = N - 1; // every task but the first, which is the caller's own
+
+  // Notified under the lock: once remaining is seen at zero, the caller's frame goes away
+  void complete() noexcept
+  {
+    ::std::lock_guard const lock{mutex};
+    --remaining;
+    done.notify_one();
+  }
+
+  void wait() noexcept
+  {
+    ::std::unique_lock lock{mutex};
+    done.wait(lock, [this] { return remaining == 0; });
+  }
+};
+
+// Lowers the index of the leftmost failure seen so far
+inline void _par_fail(::std::atomic<::std::size_t> &first_failure, ::std::size_t index) noexcept
+{
+  auto seen = first_failure.load(::std::memory_order_relaxed);
+  while (index < seen && not first_failure.compare_exchange_weak(seen, index, ::std::memory_order_acq_rel)) {
+  }
+}
+} // namespace detail
+
+/**
+ * @brief Checks if `par_conjoin` can run the tasks and conjoin their results
+ *
+ * Each task is invocable as an lvalue with an `fn::cancel_token` or with no arguments, and
+ * returns `fn::expected` or `fn::optional`; the results conjoin with `&`, and the failure of each
+ * converts into the failure of the conjunction.
+ *
+ * @tparam Fs The tasks
+ */
+template <typename... Fs>
+concept par_conjoinable //
+    = (sizeof...(Fs) > 0) && (... && detail::_par_task<Fs>)
+      && requires { typename detail::_par_conjoin_result_t<detail::_task_result_t<Fs>...>; }
+      && (... && detail::_par_failure_into<detail::_par_conjoin_result_t<detail::_task_result_t<Fs>...>,
+                                           detail::_task_result_t<Fs>>);
+
+/**
+ * @brief Runs independent tasks concurrently and conjoins their carriers, as `conjoin` does
+ *
+ * The first task runs on the calling thread, every other one on the executor, and the call returns
+ * once all are done: the latency is that of the slowest task rather than the sum of them all. The
+ * result is of the type `conjoin` gives for the carriers, and holds the same: the values of all, or
+ * the failure of the leftmost task which failed.
+ *
+ * A failure makes the tasks to its right irrelevant, which are therefore cancelled cooperatively:
+ * those not started yet are skipped, and those running see `stop_requested()` on their
+ * `fn::cancel_token`. Tasks to the left of it still run to completion, since one of them may
+ * yet fail and take precedence. An exception escaping a task counts as its failure, and is
+ * rethrown where that failure would be returned.
+ *
+ * The calling thread does not merely wait: having run the first task, it takes up, in order, every
+ * task which no worker has started yet, and then blocks only until those the workers did start are
+ * done. Called from a worker of the executor itself - a stage of an `fn::async` pipeline on
+ * `fn::thread_pool::shared()`, say - it therefore completes even where every worker is doing the
+ * same, running the tasks serially at worst.
+ *
+ * Use through the `fn::par_conjoin` nielbloid.
+ */
+constexpr inline struct par_conjoin_t final {
+  /**
+   * @brief Runs the tasks concurrently and conjoins their results
+   *
+   * @param executor The executor running all the tasks but the first
+   * @param tasks Each invocable with an `fn::cancel_token` or nothing, returning a carrier
+   * @return The conjunction of the carriers, as `conjoin` would return it
+   */
+  template <executor E, typename... Fs>
+    requires par_conjoinable<Fs...>
+  [[nodiscard]] auto operator()(E &executor, Fs &&...tasks) const
+      -> detail::_par_conjoin_result_t<detail::_task_result_t<Fs>...>
+  {
+    return _run(executor, ::std::index_sequence_for<Fs...>{}, tasks...);
+  }
+
+private:
+  template <typename E, ::std::size_t... Is, typename... Fs>
+  static auto _run(E &executor, ::std::index_sequence<Is...>, Fs &...tasks)
+      -> detail::_par_conjoin_result_t<detail::_task_result_t<Fs>...>
+  {
+    using result_t = detail::_par_conjoin_result_t<detail::_task_result_t<Fs>...>;
+    constexpr ::std::size_t count = sizeof...(Fs);
+
+    ::std::tuple<::std::optional<detail::_task_result_t<Fs>>...> results;
+    ::std::array<::std::exception_ptr, count> exceptions;
+    ::std::atomic<::std::size_t> first_failure = count;
+
+    auto const run = [&]<::std::size_t I>(::std::integral_constant<::std::size_t, I>, auto &task) noexcept {
+      if (first_failure.load(::std::memory_order_acquire) < I)
+        return;
+      try {
+        auto &slot = ::std::get<I>(results);
+        slot.emplace(detail::_invoke_task(task, detail::_cancel_token_source::make(first_failure, I)));
+        if (not slot->has_value())
+          detail::_par_fail(first_failure, I);
+      } catch (...) {
+        exceptions[I] = ::std::current_exception();
+        detail::_par_fail(first_failure, I);
+      }
+    };
+    auto const join = ::std::make_shared<detail::_par_join<count>>();
+    (void)join->claims.claim(0);
+    auto const take_up = [&]<::std::size_t I>(::std::integral_constant<::std::size_t, I> index, auto &task) noexcept {
+      if (join->claims.claim(I)) {
+        run(index, task);
+        join->complete();
+      }
+    };
+
+    // The tasks, and everything they write, live on this frame: nothing returns, not even an
+    // exception from the executor, until every task a worker has taken up is done.
+    try {
+      (
+          [&]<::std::size_t I>(::std::integral_constant<::std::size_t, I> index, auto &task) {
+            if constexpr (I > 0)
+              executor.execute([join, &run, index, &task] {
+                if (join->claims.claim(I)) {
+                  run(index, task);
+                  join->complete();
+                }
+              });
+          }(::std::integral_constant<::std::size_t, Is>{}, tasks),
+          ...);
+    } catch (...) {
+      // Whatever no worker has taken up - handed out or not - is skipped
+      detail::_par_fail(first_failure, 0);
+      (take_up(::std::integral_constant<::std::size_t, Is>{}, tasks), ...);
+      join->wait();
+      throw;
+    }
+    run(::std::integral_constant<::std::size_t, 0>{}, ::std::get<0>(::std::forward_as_tuple(tasks...)));
+    (take_up(::std::integral_constant<::std::size_t, Is>{}, tasks), ...);
+    join->wait();
+
+    auto const failed = first_failure.load(::std::memory_order_acquire);
+    if (failed == count)
+      return (... & *::std::move(::std::get<Is>(results)));
+    if (exceptions[failed])
+      ::std::rethrow_exception(exceptions[failed]);
+    ::std::optional<result_t> ret;
+    (void)(... || (Is == failed && [&] {
+             ret.emplace(detail::_par_failure<result_t>(*::std::move(::std::get<Is>(results))));
+             return true;
+           }()));
+    return *::std::move(ret);
+  }
+} par_conjoin = {}; ///< Conjoins the carriers of concurrent tasks: `par_conjoin(executor, task1, task2, ...)`
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_PAR_CONJOIN
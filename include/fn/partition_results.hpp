@@ -0,0 +1,175 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_PARTITION_RESULTS
+#define INCLUDE_FN_PARTITION_RESULTS
+
+#include <fn/collect.hpp>
+#include <fn/copack.hpp>
+#include <fn/detail/meta.hpp>
+#include <fn/expected.hpp>
+#include <fn/pack.hpp>
+#include <libfn_version.hpp>
+
+#include <array>
+#include <cstddef>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+/**
+ * @brief The two columns of a partitioned range of `expected`: every value, and every error
+ *
+ * @tparam Values The column of values
+ * @tparam Errors The column of errors, or a `pack` of one column per error alternative
+ */
+template <typename Values, typename Errors> struct partitioned final {
+  Values values;
+  Errors errors;
+};
+
+/**
+ * @brief Tag selecting one column of errors per alternative of a copack error type
+ */
+constexpr inline struct by_alternative_t final {
+  explicit by_alternative_t() = default;
+} by_alternative{}; ///< Splits the errors by alternative: `partition_results(range, by_alternative)`
+
+namespace detail {
+template <typename Res> struct _partition_result {};
+template <typename T, typename E>
+  requires(not ::std::is_void_v<T>)
+struct _partition_result<::fn::expected<T, E>> {
+  using type = ::fn::partitioned<::std::vector<T>, ::std::vector<E>>;
+};
+
+template <typename Res> struct _partition_by_alternative_result {};
+template <typename T, typename... Es>
+  requires(not ::std::is_void_v<T>) && (sizeof...(Es) > 0)
+struct _partition_by_alternative_result<::fn::expected<T, ::fn::copack<Es...>>> {
+  using type = ::fn::partitioned<::std::vector<T>, ::fn::pack<::std::vector<Es>...>>;
+};
+
+template <typename R> using _partition_result_t = typename _partition_result<_collect_element_t<R>>::type;
+
+template <typename R>
+using _partition_by_alternative_result_t = typename _partition_by_alternative_result<_collect_element_t<R>>::type;
+
+// A counting pre-pass costs one more walk over the elements: taken only where that walk is cheap and
+// idempotent, over stored elements of a sized random-access range. The elements of a transforming view
+// would be computed twice, and the predicate of a `take_while` view, which is not sized, called twice.
+template <typename R>
+concept _partition_prepass
+    = ::std::ranges::random_access_range<R> && ::std::ranges::sized_range<R>
+      && ::std::is_lvalue_reference_v<::std::ranges::range_reference_t<R>>;
+
+template <::std::size_t... Is, typename... Es>
+constexpr void _reserve_by_alternative(::std::index_sequence<Is...>, ::fn::pack<::std::vector<Es>...> &errors,
+                                       ::std::array<::std::size_t, sizeof...(Es)> const &counts)
+{
+  (get<Is>(errors).reserve(counts[Is]), ...);
+}
+
+// Appends the alternative held as it is stored - a boxed alternative stays boxed - to its column
+template <typename... Es, typename E>
+constexpr void _push_by_alternative(::fn::pack<::std::vector<Es>...> &errors, E &&error)
+{
+  FWD(error).template _invoke<void>([&errors]<typename A>(::std::in_place_type_t<A>, auto &&v) {
+    get<type_index<A, Es...>>(errors).emplace_back(FWD(v));
+  });
+}
+} // namespace detail
+
+/**
+ * @brief Splits a range of `expected` into a column of values and a column of errors, in one pass
+ *
+ * Each element goes to its column in turn, in the order met: moved where the range is an rvalue
+ * owning its elements, copied otherwise. The values are gathered into a contiguous `std::vector`;
+ * the errors either into one `std::vector` of the error type or, given `by_alternative` for a
+ * `copack` error type, into one `std::vector` per alternative, held in a `pack` in the order of the
+ * copack's alternatives, a boxed alternative kept boxed.
+ *
+ * Over stored elements of a random-access range, a counting pre-pass sizes every column first, so
+ * that none is reallocated as it grows.
+ *
+ * Use through the `fn::partition_results` nielbloid.
+ */
+constexpr inline struct partition_results_t final {
+  /**
+   * @brief Splits the range into a column of values and a column of errors
+   *
+   * @param range The `expected` elements, visited in order
+   * @return The `partitioned` columns
+   */
+  template <::std::ranges::input_range R>
+    requires requires { typename detail::_partition_result_t<R>; }
+  [[nodiscard]] constexpr auto operator()(R &&range) const -> detail::_partition_result_t<R>
+  {
+    using reference_t = detail::_collect_reference_t<R>;
+    detail::_partition_result_t<R> ret{};
+    if constexpr (detail::_partition_prepass<R>) {
+      ::std::size_t good = 0;
+      for (auto const &element : range)
+        good += element.has_value() ? 1 : 0;
+      ret.values.reserve(good);
+      ret.errors.reserve(static_cast<::std::size_t>(::std::ranges::size(range)) - good);
+    }
+    for (auto &&element : range) {
+      if (element.has_value())
+        ret.values.emplace_back(*static_cast<reference_t>(element));
+      else
+        ret.errors.emplace_back(static_cast<reference_t>(element).error());
+    }
+    return ret;
+  }
+
+  /**
+   * @brief Splits the range into a column of values and one column of errors per alternative
+   *
+   * @param range The `expected` elements with a `copack` error type, visited in order
+   * @return The `partitioned` columns, the errors a `pack` of columns by alternative
+   */
+  template <::std::ranges::input_range R>
+    requires requires { typename detail::_partition_by_alternative_result_t<R>; }
+  [[nodiscard]] constexpr auto operator()(R &&range, by_alternative_t) const
+      -> detail::_partition_by_alternative_result_t<R>
+  {
+    using reference_t = detail::_collect_reference_t<R>;
+    using error_t = typename detail::_collect_element_t<R>::error_type;
+    detail::_partition_by_alternative_result_t<R> ret{};
+    if constexpr (detail::_partition_prepass<R>) {
+      ::std::size_t good = 0;
+      ::std::array<::std::size_t, error_t::size> counts{};
+      for (auto const &element : range) {
+        if (element.has_value())
+          ++good;
+        else
+          ++counts[element.error().index];
+      }
+      ret.values.reserve(good);
+      detail::_reserve_by_alternative(::std::make_index_sequence<error_t::size>{}, ret.errors, counts);
+    }
+    for (auto &&element : range) {
+      if (element.has_value())
+        ret.values.emplace_back(*static_cast<reference_t>(element));
+      else
+        detail::_push_by_alternative(ret.errors, static_cast<reference_t>(element).error());
+    }
+    return ret;
+  }
+} partition_results = {}; ///< Splits a range of `expected` into values and errors: `partition_results(range)`
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_PARTITION_RESULTS
@@ -0,0 +1,145 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_PIPELINE_ERROR
+#define INCLUDE_FN_PIPELINE_ERROR
+
+#include <fn/concepts.hpp>
+#include <fn/copack.hpp>
+#include <fn/detail/meta.hpp>
+#include <fn/expected.hpp>
+#include <fn/functor.hpp>
+#include <fn/pack.hpp>
+#include <libfn_version.hpp>
+
+#include <concepts>
+#include <type_traits>
+#include <utility>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+struct presized_pipeline_t;
+
+/**
+ * @brief The error type of the `expected` which the steps make of a carrier of type `V`
+ *
+ * For a run of `and_then` steps, each adding its own errors, this is the copack of all of them.
+ *
+ * @tparam V The carrier entering the steps
+ * @tparam Ss The steps, such as `decltype(fn::and_then(f))`, or a composed pipeline
+ */
+template <typename V, typename... Ss>
+  requires some_expected<detail::_pipeline_result_t<V, Ss...>>
+using pipeline_error_t = typename ::std::remove_cvref_t<detail::_pipeline_result_t<V, Ss...>>::error_type;
+
+namespace detail {
+// The operand widened up front to the run's final error type, where every step accepts it and the
+// run then yields exactly what it yields without it: a step's error is widened once, where it is
+// made, and the steps after it find their operand's error already of their own result's type.
+template <typename V, typename... Ss> struct _presized {
+  static constexpr bool value = false;
+};
+template <typename V, typename... Ss>
+  requires _some_expected<::std::remove_cvref_t<V>> && _some_copack<typename ::std::remove_cvref_t<V>::error_type>
+           && some_expected<_pipeline_result_t<V, Ss...>>
+           && _some_copack<::fn::pipeline_error_t<V, Ss...>>
+           && (not ::std::is_same_v<::fn::pipeline_error_t<V, Ss...>, typename ::std::remove_cvref_t<V>::error_type>)
+           && is_superset_of<::fn::pipeline_error_t<V, Ss...>, typename ::std::remove_cvref_t<V>::error_type>
+struct _presized<V, Ss...> {
+  using operand_t = ::fn::expected<typename ::std::remove_cvref_t<V>::value_type, ::fn::pipeline_error_t<V, Ss...>>;
+  static constexpr bool value = ::std::is_constructible_v<operand_t, V> && requires {
+    typename _pipeline<operand_t &&, Ss...>::type;
+    requires ::std::same_as<_pipeline_result_t<operand_t &&, Ss...>, _pipeline_result_t<V, Ss...>>;
+  };
+};
+
+template <typename V, typename... Ss> constexpr inline bool _nothrow_presized = _pipeline<V, Ss...>::nothrow;
+template <typename V, typename... Ss>
+  requires _presized<V, Ss...>::value
+constexpr inline bool _nothrow_presized<V, Ss...>
+    = ::std::is_nothrow_constructible_v<typename _presized<V, Ss...>::operand_t, V>
+      && _pipeline<typename _presized<V, Ss...>::operand_t &&, Ss...>::nothrow
+      && ::std::is_nothrow_constructible_v<_pipeline_result_t<V, Ss...>,
+                                           typename _pipeline<typename _presized<V, Ss...>::operand_t &&, Ss...>::type>;
+
+template <typename P> struct _presized_of;
+template <typename... Ts> struct _presized_of<::fn::pack<Ts...>> {
+  using type = ::fn::functor<::fn::presized_pipeline_t, Ts...>;
+};
+} // namespace detail
+
+/**
+ * @brief A reusable pipeline whose error channel is sized for the whole run up front
+ *
+ * Runs its steps exactly as `fn::pipeline` does, with one difference: an `expected` with a copack
+ * error entering it is first widened to `pipeline_error_t` - the error type the run ends with -
+ * and only then fed to the first step. In a run of `and_then` steps an error made at one step is
+ * then widened once, directly into the final copack, and each step after it carries it on by a
+ * move of the same copack type, rather than building the next wider copack at every step.
+ *
+ * The operand is widened only where that changes nothing but the cost: where the final error is
+ * a superset of the operand's, every step accepts the wider operand, and the run yields exactly
+ * the type it yields without it. Otherwise - a step which narrows the error, such as `recover`, or
+ * a callback written for the narrower copack only - the steps run as in `fn::pipeline`.
+ *
+ * The widening is paid on every run, the successful ones too: the operand is converted into
+ * another `expected` type, which moves - or, from an lvalue, copies - its value once, before the
+ * first step. It cannot be deferred to an operand holding an error, as the steps are only sized
+ * for the final error when the operand already carries it. This pays off where errors made by the
+ * steps are frequent, or the copacks are wide; for a value which is expensive to move, in a run
+ * which rarely fails, `fn::pipeline` costs less.
+ *
+ * Use through the `fn::presized_pipeline` nielbloid.
+ */
+constexpr inline struct presized_pipeline_t final {
+  /**
+   * @brief Composes pipeline steps into one reusable step with a pre-sized error channel
+   *
+   * @param steps The steps to run, left to right; a composed pipeline contributes its own steps
+   * @return A `functor` over `fn::presized_pipeline_t`, holding the steps flat
+   */
+  template <some_functor S, some_functor... Ss>
+  [[nodiscard]] constexpr auto operator()(S &&step, Ss &&...steps) const
+      noexcept(noexcept(::fn::pipeline(FWD(step), FWD(steps)...))) ->
+      typename detail::_presized_of<decltype(::fn::pipeline(FWD(step), FWD(steps)...).data)>::type
+  {
+    return {::fn::pipeline(FWD(step), FWD(steps)...).data};
+  }
+
+  struct apply;
+} presized_pipeline = {}; ///< A pipeline widening its error once: `x | presized_pipeline(and_then(f), and_then(g))`
+
+struct presized_pipeline_t::apply final {
+  /**
+   * @brief Widens the operand's error to the run's final error type, then runs the steps
+   *
+   * @param v The monad
+   * @param steps The steps to run
+   * @return Whatever the last step returns, by value if that is an rvalue reference
+   */
+  template <some_monadic_type V, typename... Ss>
+  [[nodiscard]] constexpr auto operator()(V &&v, Ss &&...steps) const
+      noexcept(detail::_nothrow_presized<V &&, Ss &&...>
+               && ::std::is_nothrow_constructible_v<detail::_pipeline_result_t<V &&, Ss &&...>,
+                                                    typename detail::_pipeline<V &&, Ss &&...>::type>)
+          -> detail::_pipeline_result_t<V &&, Ss &&...>
+    requires requires { typename detail::_pipeline<V &&, Ss &&...>::type; }
+  {
+    if constexpr (detail::_presized<V &&, Ss &&...>::value) {
+      using operand_t = typename detail::_presized<V &&, Ss &&...>::operand_t;
+      return detail::_pipeline<operand_t &&, Ss &&...>::run(operand_t(FWD(v)), FWD(steps)...);
+    } else
+      return detail::_pipeline<V &&, Ss &&...>::run(FWD(v), FWD(steps)...);
+  }
+};
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_PIPELINE_ERROR
@@ -0,0 +1,209 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_RACE
+#define INCLUDE_FN_RACE
+
+#include <fn/cancel_token.hpp>
+#include <fn/expected.hpp>
+#include <fn/monadic.hpp>
+#include <fn/optional.hpp>
+#include <fn/pack.hpp>
+#include <fn/par_conjoin.hpp>
+#include <fn/thread_pool.hpp>
+#include <libfn_version.hpp>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+namespace detail {
+template <typename... Ts> using _race_result_t = ::std::remove_cvref_t<decltype((... | ::std::declval<Ts>()))>;
+
+// The success of one task, as the disjunction of all would carry it: its value injected into the
+// value of the whole - a void value as the empty `pack` where the whole has a value at all.
+template <typename R, typename T>
+concept _race_success_into //
+    = (some_expected_void<R> && some_expected_void<T>)
+      || (some_expected<R> && some_expected_void<T> && ::std::is_constructible_v<R, ::std::in_place_t, pack<>>)
+      || (some_expected<R> && some_expected<T> && (not some_expected_void<T>)
+          && ::std::is_constructible_v<R, ::std::in_place_t, decltype(*::std::declval<T>())>)
+      || (some_optional<R> && some_optional<T>
+          && ::std::is_constructible_v<R, ::std::in_place_t, decltype(*::std::declval<T>())>);
+
+template <typename R, typename T> constexpr auto _race_success(T &&won) -> R
+{
+  if constexpr (some_expected_void<R>)
+    return R{};
+  else if constexpr (some_expected_void<T>)
+    return R{::std::in_place, pack<>{}};
+  else
+    return R{::std::in_place, *FWD(won)};
+}
+
+// Everything the tasks share, owned by all of them: the losers may outlive the call
+template <typename... Fs> struct _race_state final {
+  static constexpr ::std::size_t count = sizeof...(Fs);
+
+  ::std::tuple<Fs...> tasks;
+  ::std::tuple<::std::optional<_task_result_t<Fs>>...> results = {};
+  ::std::array<::std::exception_ptr, count> exceptions = {};
+  _par_claims<count> claims = {};
+  ::std::atomic<::std::size_t> mark = count;
+  cancel_token token = {};
+  ::std::mutex mutex = {};
+  ::std::condition_variable done = {};
+  ::std::size_t winner = count;
+  ::std::size_t failed = 0;
+
+  template <typename... Args> explicit _race_state(Args &&...args) : tasks(FWD(args)...) {}
+
+  [[nodiscard]] auto decided() const noexcept -> bool { return winner != count || failed == count; }
+
+  // Runs the task, unless it was taken up already - by a worker, or by the caller
+  template <::std::size_t I> void run() noexcept
+  {
+    if (not claims.claim(I) || mark.load(::std::memory_order_acquire) < count)
+      return;
+    bool won = false;
+    try {
+      auto &slot = ::std::get<I>(results);
+      slot.emplace(_invoke_task(::std::get<I>(tasks), token));
+      won = slot->has_value();
+    } catch (...) {
+      exceptions[I] = ::std::current_exception();
+    }
+    ::std::lock_guard const lock{mutex};
+    if (won && winner == count) {
+      winner = I;
+      mark.store(0, ::std::memory_order_release);
+    } else if (not won) {
+      ++failed;
+    }
+    if (decided())
+      done.notify_one();
+  }
+};
+} // namespace detail
+
+/**
+ * @brief Checks if `race` can run the tasks and disjoin their results
+ *
+ * Each task is invocable as an lvalue with an `fn::cancel_token` or with no arguments, and
+ * returns `fn::expected` or `fn::optional`; the results disjoin with `|`, and the success of each
+ * converts into the success of the disjunction. The tasks are copied or moved into the race.
+ *
+ * @tparam Fs The tasks
+ */
+template <typename... Fs>
+concept raceable //
+    = (sizeof...(Fs) > 0) && (... && ::std::is_constructible_v<::std::decay_t<Fs>, Fs>)
+      && (... && detail::_par_task<::std::decay_t<Fs>>)
+      && requires { typename detail::_race_result_t<detail::_task_result_t<::std::decay_t<Fs>>...>; }
+      && (... && detail::_race_success_into<detail::_race_result_t<detail::_task_result_t<::std::decay_t<Fs>>...>,
+                                            detail::_task_result_t<::std::decay_t<Fs>>>);
+
+/**
+ * @brief Runs alternative tasks concurrently and returns the first to succeed
+ *
+ * Every task is handed to the executor, and the call returns as soon as one of them succeeds -
+ * first in time, not in order - with its value in the type `disjoin` gives for the carriers. The
+ * others are cancelled cooperatively: those not started yet are skipped, and those running see
+ * `stop_requested()` on their `fn::cancel_token`, and whatever they return is discarded. Only
+ * where every task failed does the call wait for all of them, and return their errors exactly as
+ * `disjoin` would. An exception escaping a task counts as its failure, and the leftmost one is
+ * rethrown where the errors would be returned.
+ *
+ * The calling thread blocks until the outcome is decided, and does not merely wait: it takes up, in
+ * order, every task which no worker has started yet, and runs it itself. Called from a worker of the
+ * executor - a stage of an `fn::async` pipeline on `fn::thread_pool::shared()`, say - it therefore
+ * completes even where every worker is doing the same. A task the caller runs delays the return
+ * until it sees `stop_requested()` or finishes, so a long task should poll its token.
+ *
+ * The call does not wait for the tasks it has lost interest in: each is copied or moved into
+ * storage it shares with the others, which lives until the last of them is done, but anything it
+ * refers to - and the executor - must outlive it.
+ *
+ * Use through the `fn::race` nielbloid.
+ */
+constexpr inline struct race_t final {
+  /**
+   * @brief Runs the tasks concurrently and returns the first success
+   *
+   * @param executor The executor running the tasks
+   * @param tasks Each invocable with an `fn::cancel_token` or nothing, returning a carrier
+   * @return The first success, or the disjunction of all the failures
+   */
+  template <executor E, typename... Fs>
+    requires raceable<Fs...>
+  [[nodiscard]] auto operator()(E &executor, Fs &&...tasks) const
+      -> detail::_race_result_t<detail::_task_result_t<::std::decay_t<Fs>>...>
+  {
+    auto state = ::std::make_shared<detail::_race_state<::std::decay_t<Fs>...>>(FWD(tasks)...);
+    return _run(executor, ::std::move(state), ::std::index_sequence_for<Fs...>{});
+  }
+
+private:
+  template <typename E, typename... Fs, ::std::size_t... Is>
+  static auto _run(E &executor, ::std::shared_ptr<detail::_race_state<Fs...>> state, ::std::index_sequence<Is...>)
+      -> detail::_race_result_t<detail::_task_result_t<Fs>...>
+  {
+    using result_t = detail::_race_result_t<detail::_task_result_t<Fs>...>;
+    constexpr ::std::size_t count = sizeof...(Fs);
+
+    // Every token is cancelled at once, by the mark falling below the count
+    state->token = detail::_cancel_token_source::make(state->mark, count);
+    try {
+      (executor.execute([state]() noexcept { state->template run<Is>(); }), ...);
+    } catch (...) {
+      // Whatever was handed out is cancelled; it owns what it needs
+      state->mark.store(0, ::std::memory_order_release);
+      throw;
+    }
+    // Rather than only wait, take up whatever no worker has started, in order - this may be a worker
+    // of the executor itself, which the tasks are queued behind
+    (state->template run<Is>(), ...);
+
+    ::std::size_t winner = count;
+    {
+      ::std::unique_lock lock{state->mutex};
+      state->done.wait(lock, [&] { return state->decided(); });
+      winner = state->winner;
+    }
+
+    if (winner == count) {
+      for (auto const &exception : state->exceptions)
+        if (exception)
+          ::std::rethrow_exception(exception);
+      return (... | *::std::move(::std::get<Is>(state->results)));
+    }
+    ::std::optional<result_t> ret;
+    (void)(... || (Is == winner && [&] {
+             ret.emplace(detail::_race_success<result_t>(*::std::move(::std::get<Is>(state->results))));
+             return true;
+           }()));
+    return *::std::move(ret);
+  }
+} race = {}; ///< Returns the first of the concurrent tasks to succeed: `race(executor, task1, task2, ...)`
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_RACE
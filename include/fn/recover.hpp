@@ -70,6 +70,9 @@ constexpr inline struct recover_t final {
     return {FWD(fn)};
   }
 
+  // No error to recover from on the identity cluster: skipped in a pipeline, see detail::_vacuous
+  template <typename V> static constexpr bool vacuous = some_identity<V>;
+
   struct apply;
 } recover = {}; ///< Supplies a value for the dead state: `x | recover(f)`
 
@@ -0,0 +1,238 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_THREAD_POOL
+#define INCLUDE_FN_THREAD_POOL
+
+#include <libfn_version.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+namespace detail {
+// A move-only `void()` callable, type-erased: what an executor is handed to run
+class _task final {
+  struct _base {
+    virtual ~_base() = default;
+    virtual void run() = 0;
+  };
+  template <typename F> struct _impl final : _base {
+    F fn;
+    explicit _impl(F &&f) : fn(::std::move(f)) {}
+    explicit _impl(F const &f) : fn(f) {}
+    void run() override { fn(); }
+  };
+  ::std::unique_ptr<_base> impl_;
+
+public:
+  _task() noexcept = default;
+  template <typename F>
+    requires(not ::std::is_same_v<::std::remove_cvref_t<F>, _task>) && ::std::is_invocable_v<::std::decay_t<F> &>
+  explicit _task(F &&f) : impl_(::std::make_unique<_impl<::std::decay_t<F>>>(FWD(f)))
+  {
+  }
+
+  explicit operator bool() const noexcept { return impl_ != nullptr; }
+  void operator()() { impl_->run(); }
+};
+} // namespace detail
+
+/**
+ * @brief Checks if a type can run the work of an `fn::async` pipeline
+ *
+ * An executor offers `execute(f)`, taking a move-only callable with no arguments, to be invoked
+ * once - on another thread, later, or even at once on the calling thread.
+ *
+ * @tparam E The executor
+ */
+template <typename E>
+concept executor = requires(E &e, detail::_task t) { e.execute(::std::move(t)); };
+
+/**
+ * @brief A work-stealing pool of threads; the default executor of `fn::async`
+ *
+ * Each worker owns a queue. Work submitted from a worker goes to the back of its own queue, and
+ * the worker takes its next task from there, so a stage scheduled by a finishing stage tends to
+ * run on the same thread, over warm caches; work submitted from elsewhere is spread over the
+ * queues in turn. A worker whose queue is empty steals from the front of the others', and sleeps
+ * only when there is nothing anywhere.
+ *
+ * Submission takes no lock but that of one queue: the pool's own mutex is taken only to wake a
+ * sleeping worker. A task must not throw - an exception escaping one terminates the program, as
+ * from any `std::thread`; the tasks `fn::async`, `fn::par_conjoin` and `fn::race` submit catch
+ * their own.
+ *
+ * The destructor runs every task already submitted - including what those tasks submit - then
+ * joins the workers.
+ */
+class thread_pool final {
+public:
+  /**
+   * @brief Starts the workers
+   *
+   * @param threads The number of workers; at least one is always started
+   */
+  explicit thread_pool(::std::size_t threads = ::std::thread::hardware_concurrency())
+  {
+    threads = ::std::max<::std::size_t>(threads, 1);
+    queues_.reserve(threads);
+    for (::std::size_t i = 0; i < threads; ++i)
+      queues_.push_back(::std::make_unique<_queue>());
+    workers_.reserve(threads);
+    for (::std::size_t i = 0; i < threads; ++i)
+      workers_.emplace_back([this, i] { _work(i); });
+  }
+
+  ~thread_pool()
+  {
+    {
+      ::std::lock_guard const lock{mutex_};
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &worker : workers_)
+      worker.join();
+  }
+
+  thread_pool(thread_pool const &) = delete;
+  thread_pool &operator=(thread_pool const &) = delete;
+
+  /**
+   * @brief Submits work to the pool
+   *
+   * @param fn A callable with no arguments, invoked once on one of the workers
+   */
+  template <typename F>
+    requires ::std::is_invocable_v<::std::decay_t<F> &>
+  void execute(F &&fn)
+  {
+    auto const index = current_ == this ? index_ : next_.fetch_add(1, ::std::memory_order_relaxed) % queues_.size();
+    {
+      ::std::lock_guard const lock{queues_[index]->mutex};
+      queues_[index]->tasks.emplace_back(FWD(fn));
+    }
+    pending_.fetch_add(1);
+    if (sleeping_.load() > 0) {
+      // A worker about to sleep holds the mutex from its last look at pending_ until it waits
+      ::std::lock_guard const lock{mutex_};
+      wake_.notify_one();
+    }
+  }
+
+  /**
+   * @brief The number of workers
+   */
+  [[nodiscard]] auto size() const noexcept -> ::std::size_t { return workers_.size(); }
+
+  /**
+   * @brief A pool shared by the whole program, started on first use
+   */
+  [[nodiscard]] static auto shared() -> thread_pool &
+  {
+    static thread_pool pool;
+    return pool;
+  }
+
+private:
+  struct _queue {
+    ::std::mutex mutex;
+    ::std::deque<detail::_task> tasks;
+  };
+
+  // Every submission is counted in pending_ after its task is queued, and a worker takes one off the
+  // count before it looks for one - so the worker which took it off always finds a task somewhere.
+  // A worker counts itself in sleeping_ before its last look at pending_, and a submission looks at
+  // sleeping_ after counting itself: one of the two always sees the other.
+  void _work(::std::size_t index) noexcept
+  {
+    current_ = this;
+    index_ = index;
+    for (;;) {
+      if (_claim()) {
+        _take(index)();
+        continue;
+      }
+      ::std::unique_lock lock{mutex_};
+      sleeping_.fetch_add(1);
+      wake_.wait(lock, [this] { return pending_.load() > 0 || stop_; });
+      sleeping_.fetch_sub(1);
+      if (stop_ && pending_.load() == 0)
+        return;
+    }
+  }
+
+  auto _claim() noexcept -> bool
+  {
+    auto count = pending_.load(::std::memory_order_relaxed);
+    while (count > 0)
+      if (pending_.compare_exchange_weak(count, count - 1, ::std::memory_order_acquire, ::std::memory_order_relaxed))
+        return true;
+    return false;
+  }
+
+  // The task claimed is in some queue, though another worker may be busy taking its own from the same
+  // one; a worker which misses in every queue backs off before it looks again
+  auto _take(::std::size_t index) -> detail::_task
+  {
+    for (unsigned misses = 0;; ++misses) {
+      {
+        auto &own = *queues_[index];
+        ::std::lock_guard const lock{own.mutex};
+        if (not own.tasks.empty()) {
+          auto task = ::std::move(own.tasks.back());
+          own.tasks.pop_back();
+          return task;
+        }
+      }
+      for (::std::size_t i = 1; i < queues_.size(); ++i) {
+        auto &other = *queues_[(index + i) % queues_.size()];
+        ::std::lock_guard const lock{other.mutex};
+        if (not other.tasks.empty()) {
+          auto task = ::std::move(other.tasks.front());
+          other.tasks.pop_front();
+          return task;
+        }
+      }
+      if (misses < 16)
+        ::std::this_thread::yield();
+      else
+        ::std::this_thread::sleep_for(::std::chrono::microseconds(50));
+    }
+  }
+
+  ::std::vector<::std::unique_ptr<_queue>> queues_;
+  ::std::vector<::std::thread> workers_;
+  ::std::atomic<::std::size_t> next_ = 0;
+  ::std::atomic<::std::size_t> pending_ = 0;
+  ::std::atomic<::std::size_t> sleeping_ = 0;
+  ::std::mutex mutex_;
+  ::std::condition_variable wake_;
+  bool stop_ = false;
+
+  static inline thread_local thread_pool *current_ = nullptr;
+  static inline thread_local ::std::size_t index_ = 0;
+};
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_THREAD_POOL
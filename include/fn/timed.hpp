@@ -0,0 +1,329 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_TIMED
+#define INCLUDE_FN_TIMED
+
+#include <fn/functor.hpp>
+#include <libfn_version.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+/**
+ * @brief A histogram of durations in nanoseconds, with a relative error of at most 1/16
+ *
+ * Durations below 32ns are counted exactly; above, each power of two is split into 16 buckets of
+ * equal width, as a high dynamic range histogram does with 4 significant bits. Every duration up to
+ * the largest `std::uint64_t` has its bucket, so recording never saturates.
+ */
+class latency_histogram final {
+public:
+  /**
+   * @brief The number of buckets
+   */
+  static constexpr ::std::size_t buckets = 976;
+
+  /**
+   * @brief The bucket counting the duration
+   *
+   * @param ns The duration in nanoseconds
+   */
+  [[nodiscard]] static constexpr auto bucket(::std::uint64_t ns) noexcept -> ::std::size_t
+  {
+    auto const width = static_cast<::std::size_t>(::std::bit_width(ns));
+    auto const shift = width > 5 ? width - 5 : 0;
+    return shift * 16 + static_cast<::std::size_t>(ns >> shift);
+  }
+
+  /**
+   * @brief The largest duration counted by the bucket
+   *
+   * @param index The bucket
+   */
+  [[nodiscard]] static constexpr auto highest(::std::size_t index) noexcept -> ::std::uint64_t
+  {
+    auto const shift = index < 32 ? 0 : index / 16 - 1;
+    auto const sub = static_cast<::std::uint64_t>(index - shift * 16);
+    return ((sub + 1) << shift) - 1;
+  }
+
+  /**
+   * @brief Counts a duration, once or more
+   *
+   * @param ns The duration in nanoseconds
+   * @param times How many times to count it
+   */
+  constexpr void record(::std::uint64_t ns, ::std::uint64_t times = 1) noexcept { counts_[bucket(ns)] += times; }
+
+  /**
+   * @brief Adds the counts of another histogram to this one
+   *
+   * @param other The histogram to add
+   */
+  constexpr auto operator+=(latency_histogram const &other) noexcept -> latency_histogram &
+  {
+    for (::std::size_t i = 0; i < buckets; ++i)
+      counts_[i] += other.counts_[i];
+    return *this;
+  }
+
+  /**
+   * @brief The count of the bucket
+   *
+   * @param index The bucket
+   */
+  [[nodiscard]] constexpr auto count(::std::size_t index) const noexcept -> ::std::uint64_t { return counts_[index]; }
+
+  /**
+   * @brief The number of durations counted
+   */
+  [[nodiscard]] constexpr auto count() const noexcept -> ::std::uint64_t
+  {
+    ::std::uint64_t ret = 0;
+    for (auto const c : counts_)
+      ret += c;
+    return ret;
+  }
+
+  /**
+   * @brief The duration below which the fraction `q` of the durations counted fall
+   *
+   * @param q The fraction, between 0 and 1
+   * @return The largest duration in the bucket reaching the fraction, or 0 if nothing was counted
+   */
+  [[nodiscard]] constexpr auto percentile(double q) const noexcept -> ::std::uint64_t
+  {
+    auto const total = count();
+    if (total == 0)
+      return 0;
+    auto const rank = ::std::max<::std::uint64_t>(1, static_cast<::std::uint64_t>(q * static_cast<double>(total) + 0.5));
+    ::std::uint64_t seen = 0;
+    for (::std::size_t i = 0; i < buckets; ++i) {
+      seen += counts_[i];
+      if (seen >= rank)
+        return highest(i);
+    }
+    return highest(buckets - 1);
+  }
+
+  [[nodiscard]] constexpr bool operator==(latency_histogram const &) const noexcept = default;
+
+private:
+  ::std::array<::std::uint64_t, buckets> counts_ = {};
+};
+
+static_assert(latency_histogram::bucket(~::std::uint64_t{0}) == latency_histogram::buckets - 1);
+
+namespace detail {
+// The histogram of one label on one thread. Only the owning thread writes, so an increment is a
+// relaxed load and store rather than a locked read-modify-write; the atomics are there for readers.
+struct _timed_stage final {
+  ::std::string_view label;
+  ::std::array<::std::atomic<::std::uint64_t>, latency_histogram::buckets> counts = {};
+
+  void record(::std::uint64_t ns) noexcept
+  {
+    auto &c = counts[latency_histogram::bucket(ns)];
+    c.store(c.load(::std::memory_order_relaxed) + 1, ::std::memory_order_relaxed);
+  }
+
+  void merge_into(latency_histogram &h) const noexcept
+  {
+    for (::std::size_t i = 0; i < latency_histogram::buckets; ++i)
+      h.record(latency_histogram::highest(i), counts[i].load(::std::memory_order_relaxed));
+  }
+};
+
+// The stages of every running thread which has timed one, and a histogram per label of those which
+// have ended: a thread's stages are merged into it as the thread exits, so that threads started per
+// request do not grow the registry
+struct _timed_registry final {
+  ::std::mutex mutex;
+  ::std::vector<::std::shared_ptr<_timed_stage>> stages;
+  ::std::map<::std::string_view, latency_histogram> retired;
+
+  static auto instance() -> _timed_registry &
+  {
+    static _timed_registry registry;
+    return registry;
+  }
+};
+
+// A thread's own stages: a label is matched by address first, its spelling only on a miss
+struct _timed_thread final {
+  ::std::vector<::std::shared_ptr<_timed_stage>> stages;
+
+  _timed_thread() = default;
+  _timed_thread(_timed_thread const &) = delete;
+  _timed_thread &operator=(_timed_thread const &) = delete;
+
+  // A stage whose label cannot be added to the retired histograms stays registered, counted once
+  ~_timed_thread()
+  {
+    auto &registry = _timed_registry::instance();
+    ::std::lock_guard const lock{registry.mutex};
+    for (auto const &stage : stages) {
+      try {
+        stage->merge_into(registry.retired[stage->label]);
+      } catch (...) {
+        continue;
+      }
+      ::std::erase(registry.stages, stage);
+    }
+  }
+
+  auto find(::std::string_view label) -> _timed_stage &
+  {
+    for (auto const &s : stages)
+      if (s->label.data() == label.data() && s->label.size() == label.size())
+        return *s;
+    for (auto const &s : stages)
+      if (s->label == label)
+        return *s;
+    auto stage = ::std::make_shared<_timed_stage>();
+    stage->label = label;
+    {
+      auto &registry = _timed_registry::instance();
+      ::std::lock_guard const lock{registry.mutex};
+      registry.stages.push_back(stage);
+    }
+    stages.push_back(stage);
+    return *stages.back();
+  }
+
+  static auto instance() -> _timed_thread &
+  {
+    static thread_local _timed_thread self;
+    return self;
+  }
+};
+
+// Records the time from its construction to its destruction, which follows the step's return. A
+// literal type, so that a step timed in constant evaluation runs there, untimed.
+class _timed_scope final {
+  ::std::string_view label_;
+  ::std::chrono::steady_clock::time_point start_ = {};
+
+  void _record() const noexcept
+  {
+    auto const elapsed = ::std::chrono::steady_clock::now() - start_;
+    auto const ns = ::std::chrono::duration_cast<::std::chrono::nanoseconds>(elapsed).count();
+    try {
+      _timed_thread::instance().find(label_).record(static_cast<::std::uint64_t>(ns > 0 ? ns : 0));
+    } catch (...) {
+      // A thread which cannot register a stage does not record it
+    }
+  }
+
+public:
+  constexpr explicit _timed_scope(::std::string_view label) noexcept : label_(label)
+  {
+    if (not ::std::is_constant_evaluated())
+      start_ = ::std::chrono::steady_clock::now();
+  }
+
+  constexpr ~_timed_scope()
+  {
+    if (not ::std::is_constant_evaluated())
+      _record();
+  }
+
+  _timed_scope(_timed_scope const &) = delete;
+  _timed_scope &operator=(_timed_scope const &) = delete;
+};
+} // namespace detail
+
+/**
+ * @brief Measures how long a pipeline step takes, in a histogram per label
+ *
+ * `x | timed(label, step)` is `x | step`, with the same result and `noexcept`, and the time it took
+ * recorded - whether it returned or threw - under the label. Each thread records into histograms
+ * of its own, on `std::chrono::steady_clock`, without any lock once a label has been seen on that
+ * thread; `timed_histograms` merges them. A label is a `std::string_view` of storage which lives as
+ * long as the program, such as a string literal, and steps sharing one share their histogram. In
+ * constant evaluation, the step runs untimed.
+ *
+ * Use through the `fn::timed` nielbloid.
+ */
+constexpr inline struct timed_t final {
+  /**
+   * @brief Wraps a pipeline step with the measurement of its duration
+   * @param label The name of the histogram, of static storage duration
+   * @param step The step to measure, such as `fn::and_then(f)`
+   * @return A functor that will run and measure the step
+   */
+  template <some_functor S>
+  [[nodiscard]] constexpr auto operator()(::std::string_view label, S &&step) const
+      noexcept(noexcept(functor<timed_t, ::std::string_view, decltype(step)>{label, FWD(step)}))
+          -> functor<timed_t, ::std::string_view, decltype(step)>
+  {
+    return {label, FWD(step)};
+  }
+
+  struct apply;
+} timed = {}; ///< Measures a pipeline step: `x | timed("parse", and_then(parse))`
+
+struct timed_t::apply final {
+  /**
+   * @brief Runs the step on the monad, recording its duration
+   *
+   * @param v The monad
+   * @param label The name of the histogram
+   * @param step The step
+   * @return Whatever the step returns
+   */
+  template <some_monadic_type V, some_functor S>
+  [[nodiscard]] constexpr auto operator()(V &&v, ::std::string_view label, S &&step) const
+      noexcept(noexcept(FWD(v) | FWD(step))) -> decltype(FWD(v) | FWD(step))
+    requires requires { FWD(v) | FWD(step); }
+  {
+    detail::_timed_scope const scope{label};
+    return FWD(v) | FWD(step);
+  }
+};
+
+/**
+ * @brief The histograms recorded by `fn::timed`, merged across all threads
+ *
+ * Threads may keep recording meanwhile: what they record while this runs may or may not be
+ * included. Histograms of threads which have ended are included as well, merged per label as each
+ * thread exits, so that their number does not grow with the threads started.
+ *
+ * @return The histogram of each label
+ */
+inline auto timed_histograms() -> ::std::map<::std::string_view, latency_histogram>
+{
+  auto &registry = detail::_timed_registry::instance();
+  ::std::lock_guard const lock{registry.mutex};
+  auto ret = registry.retired;
+  for (auto const &stage : registry.stages)
+    stage->merge_into(ret[stage->label]);
+  return ret;
+}
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_TIMED
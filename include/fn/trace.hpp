@@ -0,0 +1,234 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_TRACE
+#define INCLUDE_FN_TRACE
+
+#include <fn/concepts.hpp>
+#include <fn/copack.hpp>
+#include <fn/detail/meta.hpp>
+#include <libfn_version.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+/**
+ * @brief The kind of carrier a traced pipeline step was applied to
+ */
+enum class trace_carrier : unsigned char { expected, optional, choice, just };
+
+/**
+ * @brief The side of the carrier a traced pipeline step found: a value, or an error
+ *
+ * An empty `fn::optional` counts as the error side; `fn::choice` and `fn::just` always hold a
+ * value.
+ */
+enum class trace_path : unsigned char { value, error };
+
+/**
+ * @brief One pipeline step, as reported to the trace sink in the `LIBFN_TRACE` mode
+ *
+ * Every string is a view of static storage, valid for the lifetime of the program.
+ */
+struct trace_event final {
+  /**
+   * @brief The `alternative` of an error which is not a `copack`, or of the value side
+   */
+  static constexpr ::std::size_t npos = static_cast<::std::size_t>(-1);
+
+  ::std::string_view verb;                 ///< The verb's type, spelled as `type_sortkey_v` spells it
+  trace_carrier carrier;                   ///< The kind of carrier the step was applied to
+  trace_path path;                         ///< The side of the carrier the step found
+  ::std::size_t alternative = npos;        ///< On the error path, the active alternative of a `copack` error
+  ::std::string_view alternative_name = {}; ///< The type of that alternative, spelled as `type_sortkey_v` spells it
+};
+
+/**
+ * @brief A trace sink: called on the thread running the step, once per step, before it runs
+ */
+using trace_sink_t = void (*)(trace_event const &) noexcept;
+
+namespace detail {
+// A single-producer, single-consumer ring: only the owning thread writes, and drains take turns
+// under the registry's mutex. An event which finds it full is dropped, and counted.
+struct _trace_ring final {
+  static constexpr ::std::size_t capacity = 1024;
+
+  ::std::array<trace_event, capacity> events = {};
+  ::std::atomic<::std::size_t> head = 0; // written by the owning thread only
+  ::std::atomic<::std::size_t> tail = 0; // written by the drain only
+  ::std::atomic<::std::size_t> dropped = 0;
+  ::std::atomic<bool> alive = true;
+
+  void push(trace_event const &event) noexcept
+  {
+    auto const h = head.load(::std::memory_order_relaxed);
+    if (h - tail.load(::std::memory_order_acquire) == capacity) {
+      dropped.fetch_add(1, ::std::memory_order_relaxed);
+      return;
+    }
+    events[h % capacity] = event;
+    head.store(h + 1, ::std::memory_order_release);
+  }
+
+  template <typename Fn> auto drain(Fn &fn) -> ::std::size_t
+  {
+    auto const h = head.load(::std::memory_order_acquire);
+    auto t = tail.load(::std::memory_order_relaxed);
+    ::std::size_t count = 0;
+    for (; t != h; ++t, ++count) {
+      fn(static_cast<trace_event const &>(events[t % capacity]));
+      tail.store(t + 1, ::std::memory_order_release);
+    }
+    return count;
+  }
+};
+
+// The rings of every thread which has traced a step. A ring outlives its thread, until a drain
+// finds it empty.
+struct _trace_registry final {
+  ::std::mutex mutex;
+  ::std::vector<::std::shared_ptr<_trace_ring>> rings;
+  ::std::size_t dropped = 0; // by the rings no longer registered
+
+  static auto instance() -> _trace_registry &
+  {
+    static _trace_registry registry;
+    return registry;
+  }
+};
+
+// Registration takes the registry's mutex, once per thread; every write after it is lock-free
+struct _trace_thread final {
+  ::std::shared_ptr<_trace_ring> ring;
+
+  _trace_thread() : ring(::std::make_shared<_trace_ring>())
+  {
+    auto &registry = _trace_registry::instance();
+    ::std::lock_guard const lock{registry.mutex};
+    registry.rings.push_back(ring);
+  }
+  ~_trace_thread() { ring->alive.store(false, ::std::memory_order_release); }
+  _trace_thread(_trace_thread const &) = delete;
+  _trace_thread &operator=(_trace_thread const &) = delete;
+};
+
+inline void _trace_to_ring(trace_event const &event) noexcept
+{
+  try {
+    static thread_local _trace_thread self;
+    self.ring->push(event);
+  } catch (...) {
+    // A thread which cannot register a ring does not trace
+  }
+}
+
+inline constinit ::std::atomic<trace_sink_t> _trace_sink = &_trace_to_ring;
+
+template <typename T> struct _trace_alternatives;
+template <typename... Ts> struct _trace_alternatives<::fn::copack<Ts...>> final {
+  static constexpr ::std::array<::std::string_view, sizeof...(Ts)> names = {type_sortkey_v<Ts>...};
+};
+
+// Called by `functor::operator|` in the LIBFN_TRACE mode, on the carrier as it arrives
+template <typename Verb, typename V> void _trace(V const &v) noexcept
+{
+  using type = ::std::remove_cvref_t<V>;
+  trace_event event{.verb = type_sortkey_v<Verb>, .carrier = trace_carrier::just, .path = trace_path::value};
+  if constexpr (some_expected<type> || some_optional<type>) {
+    event.carrier = some_expected<type> ? trace_carrier::expected : trace_carrier::optional;
+    if (not v.has_value()) {
+      event.path = trace_path::error;
+      if constexpr (some_expected<type>) {
+        using error_type = typename type::error_type;
+        if constexpr (some_copack<error_type> && not empty_copack<error_type>) {
+          auto const &error = v.error();
+          event.alternative = error.index;
+          event.alternative_name = _trace_alternatives<error_type>::names[error.index];
+        }
+      }
+    }
+  } else if constexpr (some_choice<type>) {
+    event.carrier = trace_carrier::choice;
+  }
+  _trace_sink.load(::std::memory_order_acquire)(event);
+}
+} // namespace detail
+
+/**
+ * @brief Replaces the sink receiving trace events in the `LIBFN_TRACE` mode
+ *
+ * The default sink writes each event to a lock-free ring buffer of the thread running the step, to
+ * be collected with `drain_trace`. A replacement is called on that same thread, and must be safe
+ * to call from any thread.
+ *
+ * @param sink The new sink, or `nullptr` to restore the default
+ * @return The sink replaced
+ */
+inline auto set_trace_sink(trace_sink_t sink) noexcept -> trace_sink_t
+{
+  return detail::_trace_sink.exchange(sink != nullptr ? sink : &detail::_trace_to_ring, ::std::memory_order_acq_rel);
+}
+
+/**
+ * @brief Collects the events written by the default trace sink, from the ring buffers of all threads
+ *
+ * The events of each thread are passed in the order they were written; no order holds between
+ * threads. A ring buffer which is full drops new events until drained, and counts them. The threads
+ * running pipelines are never blocked by a drain, and drains running concurrently take turns.
+ *
+ * @param fn A callable accepting `trace_event const &`
+ * @return The number of events passed to `fn`
+ */
+template <typename Fn>
+  requires ::std::invocable<Fn &, trace_event const &>
+auto drain_trace(Fn &&fn) -> ::std::size_t
+{
+  auto &registry = detail::_trace_registry::instance();
+  ::std::lock_guard const lock{registry.mutex};
+  ::std::size_t count = 0;
+  for (auto const &ring : registry.rings)
+    count += ring->drain(fn);
+  ::std::erase_if(registry.rings, [&registry](auto const &ring) {
+    if (ring->alive.load(::std::memory_order_acquire)
+        || ring->head.load(::std::memory_order_acquire) != ring->tail.load(::std::memory_order_relaxed))
+      return false;
+    registry.dropped += ring->dropped.load(::std::memory_order_relaxed);
+    return true;
+  });
+  return count;
+}
+
+/**
+ * @brief The number of events the default trace sink has dropped on full ring buffers, so far
+ */
+inline auto trace_dropped() -> ::std::size_t
+{
+  auto &registry = detail::_trace_registry::instance();
+  ::std::lock_guard const lock{registry.mutex};
+  ::std::size_t count = registry.dropped;
+  for (auto const &ring : registry.rings)
+    count += ring->dropped.load(::std::memory_order_relaxed);
+  return count;
+}
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_TRACE
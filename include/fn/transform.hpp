@@ -13,6 +13,7 @@
 #include <fn/functional.hpp>
 #include <fn/functor.hpp>
 #include <fn/optional.hpp>
+#include <fn/pack.hpp>
 #include <libfn_version.hpp>
 
 #include <type_traits>
@@ -71,6 +72,29 @@ template <typename... Ts> struct _promoted_choice<::fn::copack<Ts...>> {
 };
 template <typename Fn, typename... V>
 using _promote_t = typename _promoted_choice<::std::remove_cvref_t<typename _apply_result<Fn, V...>::type>>::type;
+
+// Two adjacent transform callables as one: `g(f(v))`, the intermediate value handed straight from
+// one to the other. Only where that intermediate is a plain value - a reference, `void` or a copack
+// mean something different once wrapped in a carrier, so those steps are not fused. Both callables
+// are held by reference, and the fused callable lives no longer than the pipeline run holding them.
+template <typename F, typename G> struct _fused_transform final {
+  F f;
+  G g;
+
+  template <typename... Args>
+  constexpr auto operator()(Args &&...args) const
+      noexcept(::fn::is_nothrow_applicable_v<F, Args &&...>
+               && ::fn::is_nothrow_applicable_v<G, ::fn::apply_result_t<F, Args &&...>>)
+          -> ::fn::apply_result_t<G, ::fn::apply_result_t<F, Args &&...>>
+    requires ::fn::is_applicable_v<F, Args &&...>
+             && (not ::std::is_reference_v<::fn::apply_result_t<F, Args &&...>>)
+             && (not ::std::is_void_v<::fn::apply_result_t<F, Args &&...>>)
+             && (not some_copack<::fn::apply_result_t<F, Args &&...>>)
+             && ::fn::is_applicable_v<G, ::fn::apply_result_t<F, Args &&...>>
+  {
+    return ::fn::apply(static_cast<G>(g), ::fn::apply(static_cast<F>(f), FWD(args)...));
+  }
+};
 } // namespace detail
 
 /**
@@ -117,6 +141,7 @@ constexpr inline struct transform_t final {
   }
 
   struct apply;
+  struct fuse;
 } transform = {}; ///< Maps the value, staying in the carrier: `x | transform(f)`
 
 struct transform_t::apply final {
@@ -169,6 +194,25 @@ struct transform_t::apply final {
   }
 };
 
+struct transform_t::fuse final {
+  /**
+   * @brief Fuses two adjacent `transform` steps of a composed pipeline into one
+   *
+   * @param lh The step to run first
+   * @param rh The step to run next
+   * @return A `transform` step over a callable invoking `rh`'s callable on the result of `lh`'s
+   */
+  template <typename Lh, typename Rh>
+  [[nodiscard]] constexpr auto operator()(Lh &&lh, Rh &&rh) const noexcept
+      -> functor<transform_t, detail::_fused_transform<decltype(::fn::get<0>(FWD(lh).data)),
+                                                       decltype(::fn::get<0>(FWD(rh).data))>>
+    requires(::std::remove_cvref_t<Lh>::size == 1) && (::std::remove_cvref_t<Rh>::size == 1)
+  {
+    using type = detail::_fused_transform<decltype(::fn::get<0>(FWD(lh).data)), decltype(::fn::get<0>(FWD(rh).data))>;
+    return {type{::fn::get<0>(FWD(lh).data), ::fn::get<0>(FWD(rh).data)}};
+  }
+};
+
 } // namespace LIBFN_VERSION
 } // namespace fn
 
@@ -55,6 +55,9 @@ constexpr inline struct transform_error_t final {
     return {FWD(fn)};
   }
 
+  // No error to map on the identity cluster: skipped in a pipeline, see detail::_vacuous
+  template <typename V> static constexpr bool vacuous = some_identity<V>;
+
   struct apply;
 } transform_error = {}; ///< Maps the error, staying in the carrier: `x | transform_error(f)`
 
@@ -0,0 +1,157 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_TRANSFORM_ERROR_ONLY
+#define INCLUDE_FN_TRANSFORM_ERROR_ONLY
+
+#include <fn/concepts.hpp>
+#include <fn/copack.hpp>
+#include <fn/expected.hpp>
+#include <fn/functional.hpp>
+#include <fn/functor.hpp>
+#include <libfn_version.hpp>
+
+#include <type_traits>
+#include <utility>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+namespace detail {
+// The error copack with the alternative E replaced by what the callback makes of it, every other
+// alternative kept: an untouched alternative is carried over, never passed to the callback
+template <typename E, typename Fn, typename V> struct _transform_error_only {};
+template <typename E, typename Fn, typename V>
+  requires _some_expected<V> && _some_copack<typename ::std::remove_cvref_t<V>::error_type>
+           && (::std::remove_cvref_t<V>::error_type::template has_type<E>)
+           && _is_applicable<Fn, apply_const_lvalue_t<decltype(::std::declval<V>().error()), E &&>>::value
+struct _transform_error_only<E, Fn, V> {
+  using error_ref = decltype(::std::declval<V>().error());
+  using arg_t = apply_const_lvalue_t<error_ref, E &&>;
+  using mapped_t = typename _apply_result<Fn, arg_t>::type;
+
+  template <typename T> struct _rebind;
+  template <typename... Es> struct _rebind<::fn::copack<Es...>> {
+    using type = ::fn::copack_for<mapped_t, ::std::conditional_t<::std::is_same_v<Es, E>, ::fn::copack<>, Es>...>;
+  };
+  using error_type = typename _rebind<typename ::std::remove_cvref_t<V>::error_type>::type;
+  using type = ::fn::expected<typename ::std::remove_cvref_t<V>::value_type, error_type>;
+
+  // The callback's alternative, and each of the others carried over as it is stored
+  template <typename T> struct _nothrow_carry;
+  template <typename... Es> struct _nothrow_carry<::fn::copack<Es...>> {
+    static constexpr bool value
+        = (... && (::std::is_same_v<Es, E>
+                   || ::std::is_nothrow_constructible_v<type, ::fn::unexpect_t, ::std::in_place_type_t<Es>,
+                                                        apply_const_lvalue_t<error_ref, Es &&>>));
+  };
+  static constexpr bool nothrow
+      = _is_nothrow_applicable<Fn, arg_t>::value
+        && ::std::is_nothrow_constructible_v<type, ::fn::unexpect_t, mapped_t>
+        && _nothrow_carry<typename ::std::remove_cvref_t<V>::error_type>::value
+        && (::std::is_void_v<typename ::std::remove_cvref_t<V>::value_type>
+            || ::std::is_nothrow_constructible_v<type, ::std::in_place_t, decltype(*::std::declval<V>())>)
+        && (not ::std::is_same_v<type, ::std::remove_cvref_t<V>> || ::std::is_nothrow_constructible_v<type, V>);
+};
+} // namespace detail
+
+/**
+ * @brief Checks if the monadic type can be used with the `transform_error_only<E>` operation
+ *
+ * @tparam E The alternative of the error copack to map
+ * @tparam Fn The function to execute on the alternative
+ * @tparam V The monadic type
+ */
+template <typename E, typename Fn, typename V>
+concept applicable_transform_error_only = requires {
+  typename detail::_transform_error_only<E, Fn, V>::type;
+  requires(not ::std::is_void_v<typename detail::_transform_error_only<E, Fn, V>::mapped_t>);
+};
+
+/**
+ * @brief Map one alternative of a copack error, carrying the others over untouched
+ *
+ * Where `transform_error` passes every alternative of the error copack through the callback, and
+ * so makes each untouched alternative at least twice - returned by the callback, then moved into
+ * the new copack - this maps only `E`, and the callback is never instantiated for the others. Each
+ * of them is built once, directly in the result's copack, under its index there; and where the
+ * callback returns `E` again, the result is the operand's own type, and an rvalue operand holding
+ * another alternative is passed on whole - for a trivially copyable copack, a copy of its bytes.
+ * The value side is carried over as `transform_error` carries it.
+ *
+ * `E` names the alternative as it is stored - a boxed alternative as `boxed<T>` - and the callback
+ * receives it as `apply` passes it: a boxed value unboxed, unless the callback takes only the box.
+ *
+ * Use through the `fn::transform_error_only` nielbloid.
+ *
+ * @tparam E The alternative of the error copack to map
+ */
+template <typename E> struct transform_error_only_t final {
+  static_assert(detail::_is_valid_copack_subtype<E>);
+
+  /**
+   * @brief Map one alternative of the error copack
+   * @param fn The function to execute on the alternative
+   * @return A functor that will execute the function on the alternative
+   */
+  [[nodiscard]] constexpr auto operator()(auto &&fn) const
+      noexcept(noexcept(functor<transform_error_only_t, decltype(fn)>{FWD(fn)}))
+          -> functor<transform_error_only_t, decltype(fn)> //
+  {
+    return {FWD(fn)};
+  }
+
+  struct apply;
+};
+
+template <typename E> struct transform_error_only_t<E>::apply final {
+  /**
+   * @brief Maps the alternative `E` of the error, carrying the other alternatives over
+   *
+   * @param v The monad
+   * @param fn The function to apply
+   * @return An `expected` with the same value side and the error copack with `E` mapped
+   */
+  template <some_expected V, typename Fn>
+  [[nodiscard]] constexpr auto operator()(V &&v, Fn &&fn) const
+      noexcept(detail::_transform_error_only<E, Fn &&, V &&>::nothrow) ->
+      typename detail::_transform_error_only<E, Fn &&, V &&>::type
+    requires applicable_transform_error_only<E, Fn &&, V &&>
+  {
+    using type = typename detail::_transform_error_only<E, Fn &&, V &&>::type;
+    if (v.has_value()) {
+      if constexpr (::std::is_void_v<typename type::value_type>)
+        return type();
+      else
+        return type(::std::in_place, *FWD(v));
+    }
+    if constexpr (::std::is_same_v<type, ::std::remove_cvref_t<V>>) {
+      if (not v.error().template has_value<E>())
+        return type(FWD(v));
+    }
+    return FWD(v).error().template _invoke<type>([&fn]<typename A>(::std::in_place_type_t<A>, auto &&a) -> type {
+      if constexpr (::std::is_same_v<A, E>)
+        return type(::fn::unexpect, ::fn::apply(FWD(fn), FWD(a)));
+      else
+        return type(::fn::unexpect, ::std::in_place_type<A>, FWD(a));
+    });
+  }
+};
+
+/**
+ * @brief Maps one alternative of a copack error, the others untouched: `x | transform_error_only<E>(f)`
+ *
+ * @tparam E The alternative of the error copack to map
+ */
+template <typename E> constexpr inline transform_error_only_t<E> transform_error_only = {};
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_TRANSFORM_ERROR_ONLY
@@ -0,0 +1,163 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_VALUE_OR_ELSE
+#define INCLUDE_FN_VALUE_OR_ELSE
+
+#include <fn/concepts.hpp>
+#include <fn/functor.hpp>
+#include <libfn_version.hpp>
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+namespace detail {
+// The carrier holding the thunk's return, built through its invoke constructor: the value member is
+// direct-non-list-initialized from the thunk's own return, with no temporary in between - which an
+// in_place constructor's reference parameter would materialize. A reference value binds the thunk's
+// return, there being nothing to copy.
+template <typename T> constexpr inline bool _value_or_else_binds = false;
+template <typename T> constexpr inline bool _value_or_else_binds<::fn::optional<T &>> = true;
+
+template <typename T> struct _value_or_else_make final {
+  template <typename Fn>
+  [[nodiscard]] static constexpr auto make(Fn &&fn) //
+      noexcept(noexcept(T{::std::in_place, ::std::invoke(FWD(fn))})) -> T
+    requires _value_or_else_binds<T>
+  {
+    return T{::std::in_place, ::std::invoke(FWD(fn))};
+  }
+
+  template <typename Fn>
+  [[nodiscard]] static constexpr auto make(Fn &&fn) //
+      noexcept(noexcept(_optional_base<typename T::value_type>::_value_from_invoke(FWD(fn)))) -> T
+    requires some_optional<T> && (not _value_or_else_binds<T>)
+  {
+    return _optional_base<typename T::value_type>::_value_from_invoke(FWD(fn));
+  }
+
+  template <typename Fn>
+  [[nodiscard]] static constexpr auto make(Fn &&fn) //
+      noexcept(noexcept(_expected_base<typename T::value_type, typename T::error_type>::_value_from_invoke(FWD(fn))))
+          -> T
+    requires some_expected<T>
+  {
+    return _expected_base<typename T::value_type, typename T::error_type>::_value_from_invoke(FWD(fn));
+  }
+};
+} // namespace detail
+
+/**
+ * @brief Checks if the monadic type can be used with the pipeline `value_or_else` operation
+ *
+ * @tparam Fn The thunk building the fallback value
+ * @tparam V The monadic type
+ */
+// As with value_or, the fallback builds the RESULT, and the existing value must survive being carried
+// over. The thunk returns the value itself, converting to it implicitly; over a void value it returns
+// nothing. The identity cluster never lacks a value: its thunk is only required to be callable.
+template <typename Fn, typename V>
+concept applicable_value_or_else //
+    = ((some_expected_non_void<V> || some_optional<V>) && ::std::is_invocable_v<Fn>
+       && (detail::_value_or_else_binds<::std::remove_cvref_t<V>>
+               ? ::std::is_constructible_v<::std::remove_cvref_t<V>, ::std::in_place_t, ::std::invoke_result_t<Fn>>
+               : ::std::is_constructible_v<typename ::std::remove_cvref_t<V>::value_type, ::std::invoke_result_t<Fn>>)
+       && ::std::is_convertible_v<::std::invoke_result_t<Fn>, typename ::std::remove_cvref_t<V>::value_type>
+       && detail::_relocatable_value<V>)
+      || (some_expected_void<V> && ::std::is_invocable_v<Fn> && ::std::is_void_v<::std::invoke_result_t<Fn>>)
+      || ((some_just<V> || some_choice<V>) && ::std::is_invocable_v<Fn>
+          && ::std::is_constructible_v<::std::remove_cvref_t<V>, V>);
+
+/**
+ * @brief Supply a fallback for the failure state, built only where it is needed
+ *
+ * The lazy form of `value_or`: rather than the fallback's arguments, evaluated on every call, it takes
+ * a thunk which is invoked only when the operand has no value, and whose return initializes the
+ * carrier's value in place. On `choice` and `just`, which can never lack a value, and on the identity
+ * `expected`, the thunk is constrained yet dead - the operand comes back as it is.
+ *
+ * Use through the `fn::value_or_else` nielbloid.
+ */
+constexpr inline struct value_or_else_t final {
+  /**
+   * @brief Supply a fallback for the failure state, built only where it is needed
+   * @param fn The thunk returning the fallback value, invoked with no arguments
+   * @return A functor that will substitute the fallback where the value is missing
+   */
+  [[nodiscard]] constexpr auto operator()(auto &&fn) const
+      noexcept(noexcept(functor<value_or_else_t, decltype(fn)>{FWD(fn)})) -> functor<value_or_else_t, decltype(fn)>
+  {
+    return {FWD(fn)};
+  }
+
+  struct apply;
+} value_or_else = {}; ///< Substitutes a lazily built fallback for the dead state: `x | value_or_else(fn)`
+
+struct value_or_else_t::apply final {
+  /**
+   * @brief Returns the operand engaged with its own value, or the value the thunk returns
+   *
+   * @param v The monad
+   * @param fn The thunk returning the fallback value
+   * @return A carrier of the same type, holding a value
+   */
+  template <some_monadic_type V, typename Fn>
+  [[nodiscard]] constexpr auto operator()(V &&v, Fn &&fn) const //
+      noexcept(noexcept(detail::_value_or_else_make<::std::remove_cvref_t<V>>::make(::std::declval<Fn>()))
+               && detail::_nothrow_carry_value<::std::remove_cvref_t<V>, V>) -> ::std::remove_cvref_t<V>
+    requires(not some_choice<V>) && (not some_just<V>) && (not some_expected_void<V>)
+            && applicable_value_or_else<Fn &&, V &&>
+  {
+    using type = ::std::remove_cvref_t<V>;
+    return FWD(v).or_else([&fn](auto &&...) -> type { return detail::_value_or_else_make<type>::make(FWD(fn)); });
+  }
+
+  /**
+   * @brief Returns the operand engaged, having invoked the thunk if it was not
+   *
+   * @param v The monad, with a void value
+   * @param fn The thunk, returning nothing
+   * @return A carrier of the same type, holding the empty value
+   */
+  template <some_monadic_type V, typename Fn>
+  [[nodiscard]] constexpr auto operator()(V &&v, Fn &&fn) const //
+      noexcept(::std::is_nothrow_invocable_v<Fn> && ::std::is_nothrow_constructible_v<::std::remove_cvref_t<V>>)
+          -> ::std::remove_cvref_t<V>
+    requires some_expected_void<V> && applicable_value_or_else<Fn &&, V &&>
+  {
+    using type = ::std::remove_cvref_t<V>;
+    return FWD(v).or_else([&fn](auto &&...) -> type {
+      ::std::invoke(FWD(fn));
+      return type{::std::in_place};
+    });
+  }
+
+  /**
+   * @brief Returns the operand as it is: `choice` and `just` always hold a value
+   *
+   * @param v The monad
+   * @return A carrier of the same type, holding its own value
+   */
+  template <some_monadic_type V, typename Fn>
+  [[nodiscard]] constexpr auto operator()(V &&v, Fn &&) const
+      noexcept(::std::is_nothrow_constructible_v<::std::remove_cvref_t<V>, V>) -> ::std::remove_cvref_t<V>
+    requires(some_choice<V> || some_just<V>) && applicable_value_or_else<Fn &&, V &&>
+  {
+    return FWD(v);
+  }
+};
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_VALUE_OR_ELSE
@@ -0,0 +1,329 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#ifndef INCLUDE_FN_VIEWS
+#define INCLUDE_FN_VIEWS
+
+#include <fn/choice.hpp>
+#include <fn/concepts.hpp>
+#include <fn/expected.hpp>
+#include <fn/optional.hpp>
+#include <libfn_version.hpp>
+
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include <fn/detail/macro_begin.hpp>
+
+namespace fn {
+inline namespace LIBFN_VERSION {
+
+namespace detail {
+// The part of a carrier a view yields, and whether the carrier holds it. `has` is the one check made
+// of each element; `get` is unchecked, reached only where `has` answered true.
+struct _values_part final {
+  template <typename T>
+  static constexpr bool viewable = some_choice<T> || some_optional<T> || some_expected_non_void<T>;
+
+  template <typename T> [[nodiscard]] static constexpr auto has(T const &e) noexcept -> bool
+  {
+    if constexpr (some_choice<T>)
+      return true;
+    else
+      return e.has_value();
+  }
+
+  [[nodiscard]] static constexpr auto get(auto &&e) noexcept -> decltype(auto)
+  {
+    if constexpr (some_choice<decltype(e)>)
+      return FWD(e).value();
+    else
+      return *FWD(e);
+  }
+};
+
+struct _errors_part final {
+  template <typename T> static constexpr bool viewable = some_expected<T> && (not some_empty_error<T>);
+
+  template <typename T> [[nodiscard]] static constexpr auto has(T const &e) noexcept -> bool
+  {
+    return not e.has_value();
+  }
+
+  [[nodiscard]] static constexpr auto get(auto &&e) noexcept -> decltype(auto) { return FWD(e).error(); }
+};
+
+// The elements are carriers the view refers into: a range of temporaries would leave each reference
+// yielded dangling
+template <typename V, typename Part>
+concept _carrier_viewable //
+    = ::std::ranges::input_range<V> && ::std::ranges::view<V>
+      && ::std::is_reference_v<::std::ranges::range_reference_t<V>>
+      && Part::template viewable<::std::ranges::range_value_t<V>>;
+
+// The first element found, kept across calls to `begin` of a forward view and never across copies:
+// a copy of the view owns another base to point into
+template <typename I> struct _begin_cache final {
+  I iter = {};
+  bool cached = false;
+
+  constexpr _begin_cache() = default;
+  constexpr _begin_cache(_begin_cache const &) noexcept {}
+  constexpr _begin_cache(_begin_cache &&o) noexcept { o.cached = false; }
+  constexpr _begin_cache &operator=(_begin_cache const &) noexcept
+  {
+    cached = false;
+    return *this;
+  }
+  constexpr _begin_cache &operator=(_begin_cache &&o) noexcept
+  {
+    cached = false;
+    o.cached = false;
+    return *this;
+  }
+};
+
+template <typename V> struct _carrier_iterator_category {};
+template <::std::ranges::forward_range V> struct _carrier_iterator_category<V> {
+  using iterator_category = ::std::conditional_t<
+      ::std::derived_from<typename ::std::iterator_traits<::std::ranges::iterator_t<V>>::iterator_category,
+                          ::std::bidirectional_iterator_tag>,
+      ::std::bidirectional_iterator_tag, ::std::forward_iterator_tag>;
+};
+} // namespace detail
+
+/**
+ * @brief A view of the part each carrier of a range holds: its value, or its error
+ *
+ * Over a range of `optional`, `expected` or `choice`, the carriers which do not hold the part are
+ * skipped, and the part of each other one is yielded by reference, as it is stored - never copied.
+ * Each carrier is checked once, as the view steps over it; the part is then reached unchecked. Where
+ * `views::filter` followed by `views::transform` would check every value it yields twice, this checks
+ * it once. The view is bidirectional, forward or input as its base is, and common where its base is;
+ * the first carrier holding the part is found once and remembered, as `std::ranges::filter_view` does.
+ *
+ * Use through the `fn::views::values` and `fn::views::errors` adaptors.
+ *
+ * @tparam V The view of carriers
+ * @tparam Part What is yielded of each carrier
+ */
+template <typename V, typename Part>
+  requires detail::_carrier_viewable<V, Part>
+class carrier_view final : public ::std::ranges::view_interface<carrier_view<V, Part>> {
+  V base_ = V();
+  detail::_begin_cache<::std::ranges::iterator_t<V>> begin_ = {};
+
+  // The first carrier at or after `i` which holds the part
+  constexpr auto _find(::std::ranges::iterator_t<V> i) -> ::std::ranges::iterator_t<V>
+  {
+    auto const last = ::std::ranges::end(base_);
+    while (i != last && not Part::has(*i))
+      ++i;
+    return i;
+  }
+
+  class _sentinel;
+
+  class _iterator final : public detail::_carrier_iterator_category<V> {
+    friend carrier_view;
+
+    ::std::ranges::iterator_t<V> current_ = {};
+    carrier_view *parent_ = nullptr;
+
+  public:
+    using iterator_concept
+        = ::std::conditional_t<::std::ranges::bidirectional_range<V>, ::std::bidirectional_iterator_tag,
+                               ::std::conditional_t<::std::ranges::forward_range<V>, ::std::forward_iterator_tag,
+                                                    ::std::input_iterator_tag>>;
+    using value_type = ::std::remove_cvref_t<decltype(Part::get(*::std::declval<::std::ranges::iterator_t<V>>()))>;
+    using difference_type = ::std::ranges::range_difference_t<V>;
+
+    _iterator()
+      requires ::std::default_initializable<::std::ranges::iterator_t<V>>
+    = default;
+    constexpr _iterator(carrier_view &parent, ::std::ranges::iterator_t<V> current)
+        : current_(::std::move(current)), parent_(::std::addressof(parent))
+    {
+    }
+
+    [[nodiscard]] constexpr auto base() const & noexcept -> ::std::ranges::iterator_t<V> const & { return current_; }
+    [[nodiscard]] constexpr auto base() && -> ::std::ranges::iterator_t<V> { return ::std::move(current_); }
+
+    [[nodiscard]] constexpr auto operator*() const noexcept(noexcept(*current_)) -> decltype(auto)
+    {
+      return Part::get(*current_);
+    }
+
+    constexpr auto operator++() -> _iterator &
+    {
+      current_ = parent_->_find(::std::ranges::next(::std::move(current_)));
+      return *this;
+    }
+    constexpr void operator++(int)
+      requires(not ::std::ranges::forward_range<V>)
+    {
+      ++*this;
+    }
+    constexpr auto operator++(int) -> _iterator
+      requires ::std::ranges::forward_range<V>
+    {
+      auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    constexpr auto operator--() -> _iterator &
+      requires ::std::ranges::bidirectional_range<V>
+    {
+      do
+        --current_;
+      while (not Part::has(*current_));
+      return *this;
+    }
+    constexpr auto operator--(int) -> _iterator
+      requires ::std::ranges::bidirectional_range<V>
+    {
+      auto tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    [[nodiscard]] friend constexpr auto operator==(_iterator const &lh, _iterator const &rh) -> bool
+      requires ::std::equality_comparable<::std::ranges::iterator_t<V>>
+    {
+      return lh.current_ == rh.current_;
+    }
+  };
+
+  class _sentinel final {
+    ::std::ranges::sentinel_t<V> end_ = {};
+
+  public:
+    _sentinel() = default;
+    constexpr explicit _sentinel(carrier_view &parent) : end_(::std::ranges::end(parent.base_)) {}
+
+    [[nodiscard]] constexpr auto base() const -> ::std::ranges::sentinel_t<V> { return end_; }
+
+    [[nodiscard]] friend constexpr auto operator==(_iterator const &lh, _sentinel const &rh) -> bool
+    {
+      return lh.base() == rh.end_;
+    }
+  };
+
+public:
+  carrier_view()
+    requires ::std::default_initializable<V>
+  = default;
+  constexpr explicit carrier_view(V base) : base_(::std::move(base)) {}
+
+  [[nodiscard]] constexpr auto base() const & -> V
+    requires ::std::copy_constructible<V>
+  {
+    return base_;
+  }
+  [[nodiscard]] constexpr auto base() && -> V { return ::std::move(base_); }
+
+  /**
+   * @brief The first carrier holding the part, found on the first call over a forward range only
+   */
+  [[nodiscard]] constexpr auto begin() -> _iterator
+  {
+    if constexpr (::std::ranges::forward_range<V>) {
+      if (not begin_.cached) {
+        begin_.iter = _find(::std::ranges::begin(base_));
+        begin_.cached = true;
+      }
+      return {*this, begin_.iter};
+    } else {
+      return {*this, _find(::std::ranges::begin(base_))};
+    }
+  }
+
+  [[nodiscard]] constexpr auto end()
+  {
+    if constexpr (::std::ranges::common_range<V>)
+      return _iterator{*this, ::std::ranges::end(base_)};
+    else
+      return _sentinel{*this};
+  }
+};
+
+/**
+ * @brief A view of the values held by a range of `optional`, `expected` or `choice`
+ *
+ * @tparam V The view of carriers
+ */
+template <typename V> using values_view = carrier_view<V, detail::_values_part>;
+
+/**
+ * @brief A view of the errors held by a range of `expected`
+ *
+ * @tparam V The view of carriers
+ */
+template <typename V> using errors_view = carrier_view<V, detail::_errors_part>;
+
+namespace views {
+/**
+ * @brief Range adaptor to the values held by a range of carriers
+ *
+ * Use through the `fn::views::values` adaptor.
+ */
+constexpr inline struct values_t final {
+  /**
+   * @brief The view of the values held by the carriers of the range
+   * @param r The range of `optional`, `expected` or `choice`
+   * @return A `values_view` over the range
+   */
+  template <::std::ranges::viewable_range R>
+    requires detail::_carrier_viewable<::std::views::all_t<R>, detail::_values_part>
+  [[nodiscard]] constexpr auto operator()(R &&r) const -> values_view<::std::views::all_t<R>>
+  {
+    return values_view<::std::views::all_t<R>>{::std::views::all(FWD(r))};
+  }
+
+  template <::std::ranges::viewable_range R>
+    requires detail::_carrier_viewable<::std::views::all_t<R>, detail::_values_part>
+  [[nodiscard]] friend constexpr auto operator|(R &&r, values_t const &self) -> values_view<::std::views::all_t<R>>
+  {
+    return self(FWD(r));
+  }
+} values = {}; ///< The values held by a range of carriers: `range | fn::views::values`
+
+/**
+ * @brief Range adaptor to the errors held by a range of `expected`
+ *
+ * Use through the `fn::views::errors` adaptor.
+ */
+constexpr inline struct errors_t final {
+  /**
+   * @brief The view of the errors held by the carriers of the range
+   * @param r The range of `expected`
+   * @return An `errors_view` over the range
+   */
+  template <::std::ranges::viewable_range R>
+    requires detail::_carrier_viewable<::std::views::all_t<R>, detail::_errors_part>
+  [[nodiscard]] constexpr auto operator()(R &&r) const -> errors_view<::std::views::all_t<R>>
+  {
+    return errors_view<::std::views::all_t<R>>{::std::views::all(FWD(r))};
+  }
+
+  template <::std::ranges::viewable_range R>
+    requires detail::_carrier_viewable<::std::views::all_t<R>, detail::_errors_part>
+  [[nodiscard]] friend constexpr auto operator|(R &&r, errors_t const &self) -> errors_view<::std::views::all_t<R>>
+  {
+    return self(FWD(r));
+  }
+} errors = {}; ///< The errors held by a range of `expected`: `range | fn::views::errors`
+} // namespace views
+
+} // namespace LIBFN_VERSION
+} // namespace fn
+
+#include <fn/detail/macro_end.hpp>
+
+#endif // INCLUDE_FN_VIEWS
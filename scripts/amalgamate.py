@@ -21,7 +21,14 @@ Guards are kept in the output (harmless, and the result stays idempotent under
 double inclusion). Standard-library includes at a header's top level — outside
 any conditional block other than the include guard — are hoisted and
 deduplicated; inside a conditional block they stay in place, where the
-preprocessor evaluates them in context. LIBFN_CXX26 is never baked in:
+preprocessor evaluates them in context.
+
+A local include inside a conditional block (fn/functor.hpp pulls in
+fn/trace.hpp only under LIBFN_TRACE) is expanded in place, with everything it
+includes, and nothing from that expansion counts as emitted: the preprocessor
+may skip the block, so each of those headers is emitted again where it is next
+included outside one, and its guard keeps the second copy inert when the block
+was taken. The standard-library includes of such an expansion stay in place. LIBFN_CXX26 is never baked in:
 libfn_version.hpp is inlined verbatim, so one artifact serves both modes,
 selected as usual by defining the macro.
 
@@ -81,8 +88,14 @@ def public_roots() -> list[str]:
     return sorted(h for h in listed if "/detail/" not in h)
 
 
-def expand(header: str, emitted: set[str], stack: tuple[str, ...], system: set[str], out: list[str]) -> None:
-    """Depth-first expansion reproducing the preprocessor's order for `header`."""
+def expand(
+    header: str, emitted: set[str], stack: tuple[str, ...], system: set[str], out: list[str], hoist: bool = True
+) -> None:
+    """Depth-first expansion reproducing the preprocessor's order for `header`.
+
+    With `hoist` false - within a conditional block - nothing is hoisted, and
+    `emitted` is a scratch copy which the block's caller discards.
+    """
     if header in stack:
         sys.stderr.write(f"{header}: include cycle via {' -> '.join(stack)}\n")
         sys.exit(1)
@@ -106,16 +119,16 @@ def expand(header: str, emitted: set[str], stack: tuple[str, ...], system: set[s
         elif COND_CLOSE_RE.match(line):
             depth -= 1
         elif local := LOCAL_INCLUDE_RE.match(line):
-            if depth != baseline:
-                sys.stderr.write(f"{header}:{lineno}: local include inside a conditional block\n")
-                sys.exit(1)
             out.append("\n".join(kept))
             kept = []
-            expand(local.group(1), emitted, stack + (header,), system, out)
+            if depth == baseline:
+                expand(local.group(1), emitted, stack + (header,), system, out, hoist)
+            else:
+                expand(local.group(1), set(emitted), stack + (header,), system, out, hoist=False)
             out.append(f"\n// ---------- RESUME {header} ----------\n")
             continue
         elif found := SYSTEM_INCLUDE_RE.match(line):
-            if depth == baseline:
+            if depth == baseline and hoist:
                 system.add(found.group(1))
                 continue
         elif LOCAL_SUSPECT_RE.match(line):
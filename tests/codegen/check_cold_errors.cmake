@@ -0,0 +1,33 @@
+# Checks the code generation of the LIBFN_COLD_ERRORS mode, over one object built both ways:
+#
+#   cmake -DNM=<nm> -DDEFAULT=<object> -DCOLD=<object> -P check_cold_errors.cmake
+#
+# In the mode the error-side helpers of fn/expected.hpp must be emitted out of line; without it they
+# must be inlined into their callers, leaving no symbol behind.
+
+set(helpers "_carry_error|_make_error")
+
+foreach(variant DEFAULT COLD)
+    execute_process(
+        COMMAND "${NM}" -C "${${variant}}"
+        OUTPUT_VARIABLE symbols
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${NM} failed on ${${variant}}")
+    endif()
+    string(REGEX MATCHALL "[^\n]*(${helpers})[^\n]*" found "${symbols}")
+    list(LENGTH found count)
+    message(STATUS "${variant}: ${count} error-side helper symbol(s)")
+    foreach(line IN LISTS found)
+        message(STATUS "  ${line}")
+    endforeach()
+    set(count_${variant} ${count})
+endforeach()
+
+if(count_COLD EQUAL 0)
+    message(FATAL_ERROR "LIBFN_COLD_ERRORS: the error-side helpers were inlined, expected out of line")
+endif()
+if(NOT count_DEFAULT EQUAL 0)
+    message(FATAL_ERROR "default mode: the error-side helpers were emitted out of line, expected inlined")
+endif()
@@ -0,0 +1,45 @@
+# Checks the code generation of inspect_at, over one object built at two levels:
+#
+#   cmake -DNM=<nm> -DBELOW=<object> -DENABLED=<object> -P check_inspect_at.cmake
+#
+# Below LIBFN_INSPECT_LEVEL the step must leave no trace: no reference to the callback, and a loop of
+# the same size as one without the step. At the level the callback must be there, or the check above
+# proves nothing.
+
+set(callback "codegen::observe\\(int\\)")
+
+foreach(variant BELOW ENABLED)
+    execute_process(
+        COMMAND "${NM}" -C -S "${${variant}}"
+        OUTPUT_VARIABLE symbols
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${NM} failed on ${${variant}}")
+    endif()
+    string(REGEX MATCH " U ${callback}" referenced_${variant} "${symbols}")
+    foreach(function sum_with_step sum_without_step)
+        string(REGEX MATCH "[0-9a-f]+ ([0-9a-f]+) T codegen::${function}\\(" found "${symbols}")
+        if(NOT found)
+            message(FATAL_ERROR "${variant}: codegen::${function} not found")
+        endif()
+        set(size_${variant}_${function} "${CMAKE_MATCH_1}")
+    endforeach()
+    if(referenced_${variant})
+        set(referenced "callback referenced")
+    else()
+        set(referenced "no callback")
+    endif()
+    message(STATUS "${variant}: ${referenced}, with the step: 0x${size_${variant}_sum_with_step}, "
+                   "without it: 0x${size_${variant}_sum_without_step}")
+endforeach()
+
+if(NOT referenced_ENABLED)
+    message(FATAL_ERROR "at the level: the callback is not referenced, expected compiled in")
+endif()
+if(referenced_BELOW)
+    message(FATAL_ERROR "below the level: the callback is referenced, expected compiled out")
+endif()
+if(NOT size_BELOW_sum_with_step STREQUAL size_BELOW_sum_without_step)
+    message(FATAL_ERROR "below the level: the loop with the step differs in size from the loop without it")
+endif()
@@ -0,0 +1,38 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+// Built twice, optimized, with and without LIBFN_COLD_ERRORS; check_cold_errors.cmake then reads
+// the symbols of both objects. In the mode the error side of each step is a function of its own,
+// and without it that function is inlined away.
+
+#include <fn/and_then.hpp>
+#include <fn/filter.hpp>
+#include <fn/transform.hpp>
+
+#include <cstddef>
+
+namespace codegen {
+enum class Error { Negative, Odd };
+using operand_t = fn::expected<int, Error>;
+
+// The hot loop of a pipeline, each step with an error to carry or to make
+int sum_even_halves(operand_t const *first, std::size_t size)
+{
+  int sum = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    auto const r = first[i] //
+                   | fn::filter([](int v) { return v % 2 == 0; }, [](int) { return Error::Odd; })
+                   | fn::and_then([](int v) -> operand_t {
+                       if (v < 0)
+                         return fn::unexpected(Error::Negative);
+                       return v;
+                     })
+                   | fn::transform([](int v) { return v / 2; });
+    if (r.has_value())
+      sum += r.value();
+  }
+  return sum;
+}
+} // namespace codegen
@@ -0,0 +1,46 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+// Built twice, optimized, with LIBFN_INSPECT_LEVEL at 1 and at 0; check_inspect_at.cmake then reads
+// the symbols of both objects. Below the level the step costs nothing: the callback is not in the
+// object, and the loop holding the step is the same size as the loop without it.
+
+#include <fn/inspect_at.hpp>
+#include <fn/transform.hpp>
+
+#include <cstddef>
+
+namespace codegen {
+enum class Error { Negative };
+using operand_t = fn::expected<int, Error>;
+
+// Never defined: a reference to it in the object is the callback compiled in
+void observe(int v);
+
+int sum_with_step(operand_t const *first, std::size_t size)
+{
+  int sum = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    auto const r = first[i] //
+                   | fn::inspect_at<0>([](int v) { observe(v); })
+                   | fn::transform([](int v) { return v / 2; });
+    if (r.has_value())
+      sum += r.value();
+  }
+  return sum;
+}
+
+int sum_without_step(operand_t const *first, std::size_t size)
+{
+  int sum = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    auto const r = first[i] //
+                   | fn::transform([](int v) { return v / 2; });
+    if (r.has_value())
+      sum += r.value();
+  }
+  return sum;
+}
+} // namespace codegen
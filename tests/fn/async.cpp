@@ -0,0 +1,246 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/and_then.hpp>
+#include <fn/async.hpp>
+#include <fn/inspect.hpp>
+#include <fn/or_else.hpp>
+#include <fn/transform.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+enum class Error { Negative };
+
+struct Inline final {
+  int count = 0;
+  void execute(auto &&fn)
+  {
+    ++count;
+    fn();
+  }
+};
+
+// Holds back every task until released, to observe what runs before a carrier is ready
+struct Deferred final {
+  std::vector<std::function<void()>> tasks;
+  void execute(fn::detail::_task &&t)
+  {
+    tasks.emplace_back([p = std::make_shared<fn::detail::_task>(std::move(t))] { (*p)(); });
+  }
+  void run()
+  {
+    while (not tasks.empty()) {
+      auto next = std::move(tasks.front());
+      tasks.erase(tasks.begin());
+      next();
+    }
+  }
+};
+
+// Deferred, until it starts refusing work
+struct Refusing final {
+  Deferred held;
+  bool refuse = false;
+  void execute(fn::detail::_task &&t)
+  {
+    if (refuse)
+      throw std::runtime_error("refused");
+    held.execute(std::move(t));
+  }
+};
+} // namespace
+
+TEST_CASE("async", "[async][expected][optional]")
+{
+  using namespace fn;
+  using T = expected<int, copack<Error>>;
+
+  constexpr auto check = [](int v) -> expected<int, std::string> {
+    if (v > 100)
+      return unexpected<std::string>{"too big"};
+    return v;
+  };
+
+  static_assert(some_async<async<T>>);
+  static_assert(some_async<async<T> const &>);
+  static_assert(not some_async<T>);
+
+  SECTION("inline executor")
+  {
+    Inline exec;
+
+    SECTION("launch and get")
+    {
+      auto a = launch(exec, [] { return T{1}; });
+      static_assert(std::is_same_v<decltype(a), async<T>>);
+      REQUIRE(a.ready());
+      REQUIRE(std::move(a).get().value() == 1);
+      REQUIRE(exec.count == 1);
+    }
+
+    SECTION("each step is a stage on the executor")
+    {
+      int seen = 0;
+      auto a = launch(exec, [] { return T{1}; })              //
+               | transform([](int v) { return v + 1; })      //
+               | inspect([&seen](int v) { seen = v; })       //
+               | and_then(check);
+      static_assert(std::is_same_v<decltype(a), async<expected<int, copack_for<Error, std::string>>>>);
+      REQUIRE(std::move(a).get().value() == 2);
+      REQUIRE(seen == 2);
+      REQUIRE(exec.count == 4);
+    }
+
+    SECTION("errors are graded")
+    {
+      auto a = async<T>(exec, T{unexpect, Error::Negative}) | and_then(check);
+      REQUIRE(std::move(a).get().error() == copack_for<Error, std::string>{Error::Negative});
+      auto b = async<T>(exec, T{200}) | and_then(check);
+      REQUIRE(std::move(b).get().error() == copack_for<Error, std::string>{std::string{"too big"}});
+    }
+
+    SECTION("or_else")
+    {
+      auto a = async<T>(exec, T{unexpect, Error::Negative})
+               | or_else([](auto &&) -> expected<int, copack<Error>> { return 0; });
+      REQUIRE(std::move(a).get().value() == 0);
+    }
+
+    SECTION("optional")
+    {
+      auto a = launch(exec, [] { return optional<int>{3}; }) | transform([](int v) { return v * 2; });
+      static_assert(std::is_same_v<decltype(a), async<optional<int>>>);
+      REQUIRE(std::move(a).get().value() == 6);
+    }
+
+    SECTION("exception skips the remaining stages")
+    {
+      bool reached = false;
+      auto a = launch(exec, [] { return T{1}; })                                           //
+               | transform([](int) -> int { throw std::runtime_error("stage"); })         //
+               | inspect([&reached](int) { reached = true; });
+      REQUIRE_THROWS_AS(std::move(a).get(), std::runtime_error);
+      REQUIRE(not reached);
+    }
+  }
+
+  SECTION("stages run only once the carrier is ready")
+  {
+    Deferred exec;
+    int seen = 0;
+    auto a = launch(exec, [] { return T{5}; }) | inspect([&seen](int v) { seen = v; });
+    REQUIRE(not a.ready());
+    REQUIRE(seen == 0);
+    REQUIRE(exec.tasks.size() == 1);
+    exec.run();
+    REQUIRE(a.ready());
+    REQUIRE(seen == 5);
+    REQUIRE(std::move(a).get().value() == 5);
+  }
+
+  SECTION("a stage the executor refuses runs where the carrier became ready")
+  {
+    Refusing exec;
+    int seen = 0;
+    auto a = launch(exec, [] { return T{5}; }) | inspect([&seen](int v) { seen = v; });
+    exec.refuse = true;
+    exec.held.run();
+    REQUIRE(a.ready());
+    REQUIRE(seen == 5);
+    REQUIRE(std::move(a).get().value() == 5);
+  }
+
+  SECTION("valid until moved from or consumed")
+  {
+    Inline exec;
+    auto a = launch(exec, [] { return T{1}; });
+    REQUIRE(a.valid());
+    auto b = std::move(a);
+    REQUIRE(not a.valid());
+    auto c = std::move(b) | transform([](int v) { return v + 1; });
+    REQUIRE(not b.valid());
+    auto d = (std::move(c) & async<T>(exec, T{3})) | transform([](int l, int r) { return l * r; });
+    REQUIRE(not c.valid());
+    REQUIRE(d.valid());
+    REQUIRE(std::move(d).get().value() == 6);
+    REQUIRE(not d.valid());
+  }
+
+  SECTION("thread pool")
+  {
+    thread_pool pool{4};
+
+    SECTION("stages run on the workers")
+    {
+      auto const caller = std::this_thread::get_id();
+      std::atomic<bool> elsewhere = true;
+      auto a = launch(pool, [] { return T{1}; }) //
+               | inspect([&](int) { elsewhere = elsewhere && std::this_thread::get_id() != caller; })
+               | transform([](int v) { return v * 10; });
+      a.wait();
+      REQUIRE(a.ready());
+      REQUIRE(std::move(a).get().value() == 10);
+      REQUIRE(elsewhere.load());
+    }
+
+    SECTION("independent stages overlap")
+    {
+      // Neither side can finish until both have started, so this completes only if they overlap
+      std::promise<void> left_started;
+      std::promise<void> right_started;
+      auto left = launch(pool, [&]() -> T {
+        left_started.set_value();
+        right_started.get_future().wait();
+        return T{2};
+      });
+      auto right = launch(pool, [&]() -> expected<int, std::string> {
+        right_started.set_value();
+        left_started.get_future().wait();
+        return 3;
+      });
+      auto both = (std::move(left) & std::move(right))
+                  | transform([](int l, int r) { return l * r; });
+      static_assert(std::is_same_v<decltype(both), async<expected<int, copack_for<Error, std::string>>>>);
+      REQUIRE(std::move(both).get().value() == 6);
+    }
+
+    SECTION("join propagates an error")
+    {
+      auto left = launch(pool, [] { return T{unexpect, Error::Negative}; });
+      auto right = launch(pool, [] { return T{3}; });
+      auto both = std::move(left) & std::move(right);
+      REQUIRE(std::move(both).get().error() == copack<Error>{Error::Negative});
+    }
+
+    SECTION("many pipelines")
+    {
+      std::vector<async<T>> all;
+      for (int i = 0; i < 100; ++i)
+        all.push_back(launch(pool, [i] { return T{i}; }) | transform([](int v) { return v + 1; }));
+      int sum = 0;
+      for (auto &a : all)
+        sum += std::move(a).get().value();
+      REQUIRE(sum == 5050);
+    }
+  }
+
+  SECTION("shared pool")
+  {
+    auto a = launch([] { return T{7}; }) | transform([](int v) { return v * 2; });
+    REQUIRE(std::move(a).get().value() == 14);
+  }
+}
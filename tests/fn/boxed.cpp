@@ -0,0 +1,165 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/boxed.hpp>
+#include <fn/expected.hpp>
+#include <fn/inspect_error.hpp>
+#include <fn/or_else.hpp>
+#include <fn/transform_error.hpp>
+#include <fn/utility.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace {
+// As large as the file errors of the polygon example
+struct FileError final {
+  std::filesystem::path path;
+  std::error_code ec;
+  bool operator==(FileError const &) const noexcept = default;
+};
+
+struct Timeout final {
+  int ms;
+  constexpr bool operator==(Timeout const &) const noexcept = default;
+};
+
+// Throws when built from a negative number
+struct Checked final {
+  int v;
+  constexpr Checked(int i) : v(i)
+  {
+    if (i < 0)
+      throw std::runtime_error("negative");
+  }
+};
+} // namespace
+
+TEST_CASE("boxed", "[boxed]")
+{
+  using namespace fn;
+
+  static_assert(sizeof(boxed<FileError>) == sizeof(void *));
+  static_assert(std::is_nothrow_move_constructible_v<boxed<FileError>>);
+  static_assert(std::is_nothrow_move_assignable_v<boxed<FileError>>);
+  static_assert(std::is_copy_constructible_v<boxed<FileError>>);
+  static_assert(std::is_same_v<decltype(boxed{Timeout{1}}), boxed<Timeout>>);
+
+  SECTION("value semantics")
+  {
+    boxed<std::string> a{std::string(100, 'a')};
+    boxed<std::string> b = a;
+    REQUIRE(a.get() != b.get());
+    REQUIRE(*b == std::string(100, 'a'));
+    REQUIRE(a == b);
+    b->push_back('b');
+    REQUIRE(a != b);
+    REQUIRE(a->size() == 100);
+
+    auto const *p = b.get();
+    boxed<std::string> c = std::move(b);
+    REQUIRE(c.get() == p);
+    b = c;
+    REQUIRE(b == c);
+    a = std::move(c);
+    REQUIRE(a.get() == p);
+    swap(a, b);
+    REQUIRE(b.get() == p);
+    REQUIRE(std::is_same_v<decltype(*std::move(a)), std::string &&>);
+
+    // A box moved from holds no value, and compares equal only to another such box
+    boxed<std::string> d = std::move(a);
+    REQUIRE(a.get() == nullptr);
+    REQUIRE(a != d);
+    REQUIRE(d != a);
+    boxed<std::string> e = std::move(d);
+    REQUIRE(a == d);
+  }
+
+  SECTION("exception")
+  {
+    REQUIRE_THROWS_AS(boxed<Checked>(std::in_place, -1), std::runtime_error);
+    boxed<Checked> a{std::in_place, 1};
+    REQUIRE(a->v == 1);
+  }
+
+  SECTION("constant evaluation")
+  {
+    constexpr auto fn = [] {
+      boxed<Timeout> a{Timeout{3}};
+      boxed<Timeout> b = a;
+      a = std::move(b);
+      return a->ms + (a == boxed{Timeout{3}} ? 1 : 0);
+    };
+    static_assert(fn() == 4);
+  }
+}
+
+TEST_CASE("boxed copack alternative", "[boxed][copack][expected]")
+{
+  using namespace fn;
+  using error = copack_for<boxed<FileError>, Timeout>;
+  using operand_t = expected<int, error>;
+
+  static_assert(sizeof(error) == 2 * sizeof(void *));
+  static_assert(sizeof(operand_t) < sizeof(expected<int, copack_for<FileError, Timeout>>));
+
+  operand_t const failed = unexpected<error>{boxed{FileError{"/no/such/file", {}}}};
+  REQUIRE(failed.error().has_value<boxed<FileError>>());
+  REQUIRE(failed == operand_t{unexpected<error>{boxed{FileError{"/no/such/file", {}}}}});
+
+  SECTION("apply is transparent")
+  {
+    auto const name = overload([](FileError const &e) { return e.path.string(); },
+                               [](Timeout const &t) { return std::to_string(t.ms); });
+    static_assert(std::is_same_v<decltype(failed.error().apply(name)), std::string>);
+    REQUIRE(failed.error().apply(name) == "/no/such/file");
+    REQUIRE(error{Timeout{5}}.apply(name) == "5");
+
+    // The value category of the box is the value category of the value
+    auto const moved = [](auto &&e) { return std::is_rvalue_reference_v<decltype(e)>; };
+    REQUIRE(error{boxed{FileError{}}}.apply(moved));
+    REQUIRE(not failed.error().apply(moved));
+    static_assert(noexcept(failed.error().apply([](auto const &) noexcept {})));
+  }
+
+  SECTION("a callable taking the box gets the box itself")
+  {
+    auto const *const held = failed.error().get_ptr<boxed<FileError>>();
+    REQUIRE(held != nullptr);
+    auto const same = overload([held](boxed<FileError> const &b) { return b.get() == held->get(); },
+                               [](Timeout const &) { return false; });
+    REQUIRE(failed.error().apply(same));
+
+    // A generic one takes the value, as it would without the box
+    auto const generic = [](auto const &e) { return std::is_same_v<decltype(e), FileError const &>; };
+    REQUIRE(failed.error().apply(generic));
+    static_assert(not std::is_convertible_v<FileError, boxed<FileError>>);
+    static_assert(std::is_same_v<decltype(apply_r<bool>(same, failed.error())), bool>);
+    REQUIRE(apply_r<bool>(same, failed.error()));
+  }
+
+  SECTION("pipelines are transparent")
+  {
+    std::string seen;
+    auto const note = overload([&](FileError const &e) { seen = e.path.string(); }, [](Timeout const &) {});
+    auto const r = failed //
+                   | inspect_error(note)
+                   | or_else(overload([](FileError const &) -> operand_t { return 0; },
+                                      [](Timeout const &t) -> operand_t { return t.ms; }));
+    REQUIRE(seen == "/no/such/file");
+    REQUIRE(r.value() == 0);
+
+    auto const code = operand_t{failed} //
+                      | transform_error(overload([](FileError &&) { return 1; }, [](Timeout &&) { return 2; }));
+    REQUIRE(code.error() == copack<int>{1});
+  }
+}
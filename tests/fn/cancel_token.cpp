@@ -0,0 +1,41 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/cancel_token.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+TEST_CASE("cancel_token", "[cancel_token]")
+{
+  using namespace fn;
+
+  SECTION("default is never cancelled")
+  {
+    constexpr cancel_token token{};
+    REQUIRE(not token.stop_requested());
+  }
+
+  SECTION("cancelled once the shared mark falls below the index")
+  {
+    std::atomic<std::size_t> mark = 3;
+    auto const first = detail::_cancel_token_source::make(mark, 0);
+    auto const last = detail::_cancel_token_source::make(mark, 2);
+    REQUIRE(not first.stop_requested());
+    REQUIRE(not last.stop_requested());
+    mark.store(1);
+    REQUIRE(not first.stop_requested());
+    REQUIRE(last.stop_requested());
+    mark.store(0);
+    REQUIRE(not first.stop_requested());
+  }
+
+  // Only the algorithms handing tokens out can tie one to a mark
+  static_assert(not std::is_constructible_v<cancel_token, std::atomic<std::size_t> const &, std::size_t>);
+  static_assert(std::is_nothrow_copy_constructible_v<cancel_token>);
+}
@@ -0,0 +1,130 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/and_then.hpp>
+#include <fn/catching.hpp>
+#include <fn/transform_error.hpp>
+#include <fn/utility.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace {
+enum class Error { Bad };
+
+struct ParseError final {
+  int line;
+};
+
+// Legacy code, reporting failures by throwing
+auto legacy_parse(std::string const &s) -> int
+{
+  if (s.empty())
+    throw ParseError{1};
+  if (s == "?")
+    throw std::invalid_argument("not a number");
+  if (s == "!")
+    throw 42;
+  return static_cast<int>(s.size());
+}
+} // namespace
+
+TEST_CASE("catching", "[catching][expected][copack]")
+{
+  using namespace fn;
+  using error_t = copack_for<ParseError, std::invalid_argument>;
+
+  auto const parse = catching<ParseError, std::invalid_argument>(legacy_parse);
+  static_assert(std::is_same_v<decltype(parse(std::string{})), expected<int, error_t>>);
+  static_assert(not noexcept(parse(std::string{})));
+
+  REQUIRE(parse(std::string{"abc"}).value() == 3);
+  REQUIRE(parse(std::string{}).error().get_ptr<ParseError>()->line == 1);
+  REQUIRE(std::string{parse(std::string{"?"}).error().get_ptr<std::invalid_argument>()->what()} == "not a number");
+  REQUIRE_THROWS_AS(parse(std::string{"!"}), int);
+
+  SECTION("the first type listed wins")
+  {
+    auto const first = catching<std::invalid_argument, std::logic_error>(legacy_parse);
+    REQUIRE(first(std::string{"?"}).error().has_value<std::invalid_argument>());
+    auto const base = catching<std::logic_error, std::invalid_argument>(legacy_parse);
+    REQUIRE(base(std::string{"?"}).error().has_value<std::logic_error>());
+  }
+
+  SECTION("exception_ptr catches everything else")
+  {
+    auto const all = catching<ParseError, std::exception_ptr>(legacy_parse);
+    static_assert(noexcept(all(std::string{})));
+    REQUIRE(all(std::string{}).error().has_value<ParseError>());
+    auto const r = all(std::string{"!"});
+    REQUIRE(r.error().has_value<std::exception_ptr>());
+    REQUIRE_THROWS_AS(std::rethrow_exception(*r.error().get_ptr<std::exception_ptr>()), int);
+  }
+
+  SECTION("void result")
+  {
+    int calls = 0;
+    auto const touch = catching<ParseError>([&calls](bool fail) {
+      ++calls;
+      if (fail)
+        throw ParseError{2};
+    });
+    static_assert(std::is_same_v<decltype(touch(true)), expected<void, copack<ParseError>>>);
+    REQUIRE(touch(false).has_value());
+    REQUIRE(touch(true).error().get_ptr<ParseError>()->line == 2);
+    REQUIRE(calls == 2);
+  }
+
+  SECTION("an expected result is widened")
+  {
+    auto const checked = catching<ParseError>([](std::string const &s) -> expected<int, Error> {
+      if (s == "bad")
+        return unexpected(Error::Bad);
+      return legacy_parse(s);
+    });
+    using type = decltype(checked(std::string{}));
+    static_assert(std::is_same_v<type, expected<int, copack_for<Error, ParseError>>>);
+    REQUIRE(checked(std::string{"ab"}).value() == 2);
+    REQUIRE(checked(std::string{"bad"}).error().has_value<Error>());
+    REQUIRE(checked(std::string{}).error().has_value<ParseError>());
+  }
+
+  SECTION("in a pipeline")
+  {
+    using operand_t = expected<std::string, error_t>;
+    auto const describe = overload([](ParseError const &e) { return "line " + std::to_string(e.line); },
+                                   [](std::invalid_argument const &e) { return std::string{e.what()}; });
+
+    auto const r1 = operand_t{"abcd"} | and_then(parse);
+    REQUIRE(r1.value() == 4);
+    auto const r2 = operand_t{""} | and_then(parse) | transform_error(describe);
+    REQUIRE(r2.error() == copack<std::string>{std::string{"line 1"}});
+
+    // Nothing is left to throw, and the pipeline is noexcept
+    auto const all = catching<ParseError, std::exception_ptr>(legacy_parse);
+    using all_t = expected<std::string, copack_for<ParseError, std::exception_ptr>>;
+    all_t const v{"x"};
+    static_assert(noexcept(v | and_then(all)));
+    REQUIRE((v | and_then(all)).value() == 1);
+  }
+
+  SECTION("constant evaluation")
+  {
+    constexpr auto fn = [] {
+      auto const c = catching<ParseError>([](int i) {
+        if (i < 0)
+          throw ParseError{i};
+        return i * 2;
+      });
+      return c(21).value();
+    };
+    static_assert(fn() == 42);
+  }
+}
@@ -0,0 +1,221 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/collect.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <cstddef>
+#include <forward_list>
+#include <memory>
+#include <ranges>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+enum class Error { Negative, Overflow };
+
+struct Counted final {
+  int v = 0;
+  int copies = 0;
+  int moves = 0;
+  constexpr Counted(int i) : v(i) {}
+  constexpr Counted(Counted &&o) noexcept : v(o.v), copies(o.copies), moves(o.moves + 1) {}
+  constexpr Counted(Counted const &o) : v(o.v), copies(o.copies + 1), moves(o.moves) {}
+  Counted &operator=(Counted &&) = delete;
+  Counted &operator=(Counted const &) = delete;
+};
+
+// Counts the allocations made through it
+template <typename T> struct counting_allocator {
+  using value_type = T;
+  int *count;
+  constexpr explicit counting_allocator(int *c) noexcept : count(c) {}
+  template <typename U> constexpr counting_allocator(counting_allocator<U> const &o) noexcept : count(o.count) {}
+  auto allocate(std::size_t n) -> T *
+  {
+    ++*count;
+    return std::allocator<T>{}.allocate(n);
+  }
+  void deallocate(T *p, std::size_t n) noexcept { std::allocator<T>{}.deallocate(p, n); }
+  template <typename U> bool operator==(counting_allocator<U> const &) const noexcept { return true; }
+};
+
+template <typename T> struct counted_vector : std::vector<T, counting_allocator<T>> {
+  static inline int allocations = 0;
+  counted_vector() : std::vector<T, counting_allocator<T>>(counting_allocator<T>{&allocations}) {}
+};
+} // namespace
+
+TEST_CASE("collect", "[collect][expected][optional][choice]")
+{
+  using namespace fn;
+  using operand_t = expected<int, Error>;
+
+  static_assert(std::is_same_v<decltype(collect<std::vector<int>>(std::declval<std::vector<operand_t> &>())),
+                               expected<std::vector<int>, Error>>);
+  static_assert(collectable<std::vector<operand_t>, std::vector<int>>);
+  static_assert(collectable<std::vector<operand_t>, std::set<long>>);
+  static_assert(not collectable<std::vector<expected<void, Error>>, std::vector<int>>);
+  static_assert(not collectable<std::vector<int>, std::vector<int>>);
+  static_assert(not collectable<std::vector<operand_t>, std::vector<std::string>>);
+
+  SECTION("expected")
+  {
+    std::vector<operand_t> const good{1, 2, 3};
+    REQUIRE(collect<std::vector<int>>(good).value() == std::vector<int>{1, 2, 3});
+    REQUIRE(collect<std::vector<int>>(std::vector<operand_t>{}).value().empty());
+    REQUIRE(collect<std::set<int>>(std::vector<operand_t>{3, 1, 3}).value() == std::set<int>{1, 3});
+
+    SECTION("first failure stops the loop")
+    {
+      int visited = 0;
+      std::array<operand_t, 4> const mixed{1, unexpected(Error::Negative), 3, unexpected(Error::Overflow)};
+      auto const r = collect<std::vector<int>>(mixed | std::views::transform([&visited](operand_t const &v) {
+                                                 ++visited;
+                                                 return v;
+                                               }));
+      REQUIRE(r.error() == Error::Negative);
+      REQUIRE(visited == 2);
+    }
+
+    SECTION("copack error is kept as the element holds it")
+    {
+      using error_t = copack_for<Error, std::string>;
+      std::vector<expected<int, error_t>> const v{1, unexpected<error_t>{std::string{"bad"}}};
+      auto const r = collect<std::vector<int>>(v);
+      static_assert(std::is_same_v<decltype(r), expected<std::vector<int>, error_t> const>);
+      REQUIRE(r.error() == error_t{std::string{"bad"}});
+    }
+
+    SECTION("constant evaluation")
+    {
+      constexpr auto fn = [] {
+        std::array<operand_t, 3> const v{1, 2, 3};
+        auto const r = collect<std::vector<int>>(v);
+        return r.value().size() + static_cast<std::size_t>(r.value().back());
+      };
+      static_assert(fn() == 6);
+    }
+  }
+
+  SECTION("optional")
+  {
+    std::vector<optional<int>> v{1, 2};
+    REQUIRE(collect<std::vector<int>>(v).value() == std::vector<int>{1, 2});
+    v.emplace_back(std::nullopt);
+    v.emplace_back(4);
+    static_assert(std::is_same_v<decltype(collect<std::vector<int>>(v)), optional<std::vector<int>>>);
+    REQUIRE(not collect<std::vector<int>>(v).has_value());
+
+    int a = 1;
+    std::vector<optional<int &>> const refs{optional<int &>{a}};
+    REQUIRE(collect<std::vector<int>>(refs).value() == std::vector<int>{1});
+  }
+
+  SECTION("choice")
+  {
+    using choice_t = choice_for<int, std::string>;
+    std::vector<choice_t> const v{choice_t{1}, choice_t{std::string{"a"}}};
+    auto const r = collect<std::vector<copack_for<int, std::string>>>(v);
+    static_assert(std::is_same_v<decltype(r), just<std::vector<copack_for<int, std::string>>> const>);
+    REQUIRE(r.value().size() == 2);
+    REQUIRE(r.value()[1] == copack_for<int, std::string>{std::string{"a"}});
+  }
+
+  SECTION("values are moved from an owning rvalue, copied otherwise")
+  {
+    using counted_t = expected<Counted, Error>;
+    std::vector<counted_t> v;
+    v.reserve(3);
+    for (int i = 0; i < 3; ++i)
+      v.emplace_back(std::in_place, i);
+
+    auto const copied = collect<std::vector<Counted>>(v).value();
+    for (auto const &c : copied)
+      REQUIRE(c.copies == 1);
+
+    // A view refers to elements owned elsewhere, and is not moved from
+    auto const viewed = collect<std::vector<Counted>>(std::views::all(v)).value();
+    REQUIRE(viewed[0].copies == 1);
+
+    auto const moved = collect<std::vector<Counted>>(std::move(v)).value();
+    for (auto const &c : moved) {
+      REQUIRE(c.copies == 0);
+      REQUIRE(c.moves == 1);
+    }
+  }
+}
+
+TEST_CASE("collect_all", "[collect][expected]")
+{
+  using namespace fn;
+  using operand_t = expected<int, Error>;
+
+  std::vector<operand_t> v{1, 2};
+  REQUIRE(collect_all<std::vector<int>>(v).value() == std::vector<int>{1, 2});
+
+  v.emplace_back(unexpected(Error::Negative));
+  v.emplace_back(4);
+  v.emplace_back(unexpected(Error::Overflow));
+  auto const r = collect_all<std::vector<int>>(v);
+  static_assert(std::is_same_v<decltype(r), expected<std::vector<int>, std::vector<copack<Error>>> const>);
+  REQUIRE(r.error() == std::vector<copack<Error>>{Error::Negative, Error::Overflow});
+
+  SECTION("copack error is not widened further")
+  {
+    using error_t = copack_for<Error, std::string>;
+    std::vector<expected<int, error_t>> const w{unexpected<error_t>{std::string{"bad"}}, 1,
+                                                unexpected<error_t>{Error::Overflow}};
+    auto const s = collect_all<std::vector<int>>(w);
+    static_assert(std::is_same_v<decltype(s), expected<std::vector<int>, std::vector<error_t>> const>);
+    REQUIRE(s.error() == std::vector<error_t>{error_t{std::string{"bad"}}, error_t{Error::Overflow}});
+  }
+
+  static_assert(not std::is_invocable_v<collect_all_t<std::vector<int>> const &, std::vector<optional<int>> &>);
+}
+
+// The manual loop this replaces grows the vector as it goes; collect reserves once for a sized
+// range, so it allocates once however long the range is.
+TEST_CASE("collect against the manual loop", "[collect][expected]")
+{
+  using namespace fn;
+  using operand_t = expected<int, Error>;
+
+  std::vector<operand_t> input;
+  for (int i = 0; i < 1000; ++i)
+    input.emplace_back(i);
+
+  auto const manual = [](std::vector<operand_t> const &in) -> expected<counted_vector<int>, Error> {
+    counted_vector<int> out;
+    for (auto const &e : in) {
+      if (not e.has_value())
+        return unexpected(e.error());
+      out.push_back(*e);
+    }
+    return out;
+  };
+
+  counted_vector<int>::allocations = 0;
+  auto const a = manual(input);
+  int const manual_allocations = counted_vector<int>::allocations;
+  REQUIRE(manual_allocations > 1);
+
+  counted_vector<int>::allocations = 0;
+  auto const b = collect<counted_vector<int>>(input);
+  REQUIRE(counted_vector<int>::allocations == 1);
+  REQUIRE(b.value().capacity() == input.size());
+  REQUIRE(std::ranges::equal(a.value(), b.value()));
+
+  // An unsized range cannot be reserved for
+  std::forward_list<operand_t> const list{1, 2, 3};
+  counted_vector<int>::allocations = 0;
+  REQUIRE(collect<counted_vector<int>>(list).value().size() == 3);
+  REQUIRE(counted_vector<int>::allocations > 1);
+}
@@ -11,6 +11,7 @@
 
 #include <array>
 #include <concepts>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -39,6 +40,13 @@ struct NonCopyable final {
   NonCopyable &operator=(NonCopyable const &) = delete;
 };
 
+// Trivially copyable, with a size and alignment of its own
+struct Point final {
+  short x;
+  short y;
+  constexpr bool operator==(Point const &) const noexcept = default;
+};
+
 template <fn::copack<bool, int> S> struct copack_nttp final {};
 template <fn::some_copack auto S> struct some_copack_nttp final {};
 template <fn::some_copack auto S> auto read_nttp()
@@ -573,6 +581,28 @@ TEST_CASE("copack basic functionality tests", "[copack]")
       CHECK(b.apply([](auto &&i) -> bool { return static_cast<bool>(i); }));
     }
 
+    SECTION("trivially copyable alternatives are copied as bytes")
+    {
+      // past four alternatives the union nests, and each alternative still lives at its start
+      using W = fn::copack_for<char, short, int, long, float, double, Point>;
+      using N = fn::copack_for<double, char, Point>;
+      static_assert(W::_bitwise_widenable<N> && not T::_bitwise_widenable<copack<std::string>>);
+
+      N const a{3.5};
+      W const b{a};
+      CHECK(b.has_value<double>());
+      CHECK(b.index == W{3.5}.index);
+      CHECK(*b.get_ptr<double>() == 3.5);
+      W const c{N{'x'}};
+      CHECK(*c.get_ptr<char>() == 'x');
+      W const d{std::in_place_type<N>, N{Point{1, 2}}};
+      CHECK(*d.get_ptr<Point>() == Point{1, 2});
+
+      // the copy a constant evaluation makes instead
+      constexpr W e{N{Point{3, 4}}};
+      static_assert(*e.get_ptr<Point>() == Point{3, 4});
+    }
+
     SECTION("constexpr")
     {
       constexpr S a{std::in_place_type<int>, 42};
@@ -1599,6 +1629,27 @@ TEST_CASE("copack triviality", "[copack][triviality]")
   }
 }
 
+TEST_CASE("copack layout", "[copack][layout]")
+{
+  using fn::copack;
+
+  // the index is the narrowest unsigned type to count the alternatives, so it neither widens nor
+  // word-aligns a copack of small alternatives
+  static_assert(std::is_same_v<copack<int>::index_t, std::uint8_t>);
+  static_assert(std::is_same_v<fn::copack_for<char, int, double>::index_t, std::uint8_t>);
+  static_assert(sizeof(fn::copack_for<char, short>) == 2 * sizeof(short));
+  static_assert(sizeof(fn::copack_for<float, int>) == 2 * sizeof(int));
+  static_assert(alignof(fn::copack_for<float, int>) == alignof(int));
+  static_assert(std::is_same_v<fn::detail::_copack_index_t<255>, std::uint8_t>);
+  static_assert(std::is_same_v<fn::detail::_copack_index_t<256>, std::uint16_t>);
+  static_assert(std::is_same_v<fn::detail::_copack_index_t<65536>, std::uint32_t>);
+
+  constexpr fn::copack_for<float, int> a{2.5f};
+  static_assert(a.index == fn::detail::type_index<float, float, int>);
+  static_assert(a.has_value<float>());
+  SUCCEED();
+}
+
 TEST_CASE("copack type collapsing", "[copack][transform][normalized]")
 {
   using ::fn::copack;
@@ -0,0 +1,223 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/coroutine.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+struct Error final {
+  std::string what;
+  bool operator==(Error const &) const = default;
+};
+
+struct Overflow final {
+  int limit;
+  bool operator==(Overflow const &) const = default;
+};
+
+struct Counted final {
+  static int live;
+  int v;
+  explicit Counted(int v) : v(v) { ++live; }
+  Counted(Counted const &o) : v(o.v) { ++live; }
+  ~Counted() { --live; }
+};
+int Counted::live = 0;
+
+auto parse(int v) -> fn::expected<int, Error>
+{
+  if (v < 0)
+    return fn::unexpected<Error>{"negative"};
+  return v;
+}
+
+auto check(int v) -> fn::expected<int, Overflow>
+{
+  if (v > 100)
+    return fn::unexpected<Overflow>{100};
+  return v;
+}
+
+using both_t = fn::copack_for<Error, Overflow>;
+
+auto sum(int a, int b) -> fn::expected<int, both_t>
+{
+  Counted const guard{a};
+  int const x = co_await parse(a);
+  int const y = co_await check(x + b);
+  co_return y + guard.v;
+}
+
+auto nested(int a) -> fn::expected<int, both_t>
+{
+  int const x = co_await sum(a, 1);
+  co_return co_await sum(x, 1);
+}
+
+auto lend(fn::expected<std::string, Error> const &s) -> fn::expected<std::size_t, Error>
+{
+  std::string const &v = co_await s;
+  co_return v.size();
+}
+
+auto touch(bool fail) -> fn::expected<void, Error>
+{
+  if (fail)
+    co_await fn::expected<void, Error>{fn::unexpect, "touch"};
+  co_return;
+}
+
+auto half(int v) -> fn::optional<int>
+{
+  if (v % 2 != 0)
+    return {};
+  return v / 2;
+}
+
+auto quarter(int v) -> fn::optional<int> { co_return co_await half(co_await half(v)); }
+
+auto occupied(fn::coroutine_arena const &arena) -> fn::expected<std::size_t, Error> { co_return arena.used(); }
+
+auto raise(int v) -> fn::expected<int, Error>
+{
+  int const x = co_await parse(v);
+  if (x == 0)
+    throw std::runtime_error("zero");
+  co_return x;
+}
+} // namespace
+
+TEST_CASE("coroutine", "[coroutine][expected][optional]")
+{
+  SECTION("expected")
+  {
+    SECTION("value")
+    {
+      auto const r = sum(1, 2);
+      static_assert(std::is_same_v<decltype(r), fn::expected<int, both_t> const>);
+      REQUIRE(r.value() == 4);
+      REQUIRE(Counted::live == 0);
+    }
+
+    SECTION("first error short-circuits")
+    {
+      auto const r = sum(-1, 2);
+      REQUIRE(not r.has_value());
+      REQUIRE(r.error().has_type<Error>);
+      REQUIRE(r.error() == both_t{Error{"negative"}});
+      REQUIRE(Counted::live == 0);
+    }
+
+    SECTION("second error short-circuits")
+    {
+      auto const r = sum(1, 200);
+      REQUIRE(not r.has_value());
+      REQUIRE(r.error() == both_t{Overflow{100}});
+      REQUIRE(Counted::live == 0);
+    }
+
+    SECTION("nested")
+    {
+      REQUIRE(nested(1).value() == 7);
+      REQUIRE(nested(99).error() == both_t{Overflow{100}});
+      REQUIRE(Counted::live == 0);
+    }
+
+    SECTION("lvalue operand is lent")
+    {
+      fn::expected<std::string, Error> const s{"abc"};
+      REQUIRE(lend(s).value() == 3);
+      REQUIRE(s.value() == "abc");
+      REQUIRE(lend(fn::unexpected<Error>{"none"}).error().what == "none");
+    }
+
+    SECTION("void value")
+    {
+      REQUIRE(touch(false).has_value());
+      REQUIRE(touch(true).error().what == "touch");
+    }
+
+    SECTION("exception")
+    {
+      REQUIRE(raise(1).value() == 1);
+      REQUIRE(raise(-1).error().what == "negative");
+      REQUIRE_THROWS_AS(raise(0), std::runtime_error);
+    }
+  }
+
+  SECTION("optional")
+  {
+    REQUIRE(quarter(8).value() == 2);
+    REQUIRE(not quarter(6).has_value());
+    REQUIRE(not quarter(3).has_value());
+  }
+
+  SECTION("arena")
+  {
+    alignas(fn::coroutine_arena::alignment) std::array<std::byte, 4096> buffer;
+    fn::coroutine_arena arena{buffer};
+    REQUIRE(arena.used() == 0);
+
+    SECTION("frames are taken and returned")
+    {
+      REQUIRE(occupied(arena).value() == 0);
+      {
+        fn::coroutine_arena::scope const use{arena};
+        REQUIRE(occupied(arena).value() > 0);
+        REQUIRE(arena.used() == 0);
+        REQUIRE(nested(1).value() == 7);
+        REQUIRE(arena.used() == 0);
+        REQUIRE(nested(99).error() == both_t{Overflow{100}});
+        REQUIRE(arena.used() == 0);
+        REQUIRE_THROWS_AS(raise(0), std::runtime_error);
+        REQUIRE(arena.used() == 0);
+      }
+      REQUIRE(occupied(arena).value() == 0);
+    }
+
+    SECTION("scopes nest")
+    {
+      alignas(fn::coroutine_arena::alignment) std::array<std::byte, 1024> other;
+      fn::coroutine_arena inner{other};
+      fn::coroutine_arena::scope const outer_use{arena};
+      {
+        fn::coroutine_arena::scope const inner_use{inner};
+        REQUIRE(occupied(arena).value() == 0);
+        REQUIRE(occupied(inner).value() > 0);
+      }
+      REQUIRE(occupied(arena).value() > 0);
+    }
+
+    SECTION("exhausted arena falls back to the heap")
+    {
+      fn::coroutine_arena small{std::span<std::byte>{buffer}.first(8)};
+      fn::coroutine_arena::scope const use{small};
+      REQUIRE(sum(1, 2).value() == 4);
+      REQUIRE(small.used() == 0);
+    }
+
+    SECTION("allocation is a stack")
+    {
+      void *const a = arena.allocate(1);
+      void *const b = arena.allocate(1);
+      REQUIRE(arena.used() == 2 * fn::coroutine_arena::alignment);
+      arena.deallocate(a, 1);
+      REQUIRE(arena.used() == 2 * fn::coroutine_arena::alignment);
+      arena.deallocate(b, 1);
+      REQUIRE(arena.used() == fn::coroutine_arena::alignment);
+      arena.deallocate(a, 1);
+      REQUIRE(arena.used() == 0);
+      REQUIRE(arena.allocate(buffer.size() + 1) == nullptr);
+    }
+  }
+}
@@ -0,0 +1,167 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/and_then.hpp>
+#include <fn/detail/uses_allocator.hpp>
+#include <fn/expected.hpp>
+#include <fn/optional.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+enum class Error { Bad };
+
+struct Timeout final {
+  int ms;
+  constexpr bool operator==(Timeout const &) const noexcept = default;
+};
+
+using alloc_t = std::pmr::polymorphic_allocator<>;
+
+// Any payload not handed the arena falls back on the default resource, which then throws
+struct no_default_resource final {
+  std::pmr::memory_resource *previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+  ~no_default_resource() { std::pmr::set_default_resource(previous); }
+};
+
+auto resource_of(std::pmr::string const &s) -> std::pmr::memory_resource * { return s.get_allocator().resource(); }
+
+constexpr std::string_view text = "a payload long enough to defeat the small string optimization";
+} // namespace
+
+TEST_CASE("_uses_allocator", "[uses_allocator]")
+{
+  using fn::detail::_uses_allocator;
+
+  static_assert(_uses_allocator<std::pmr::string, alloc_t>);
+  static_assert(not _uses_allocator<int, alloc_t>);
+  static_assert(not _uses_allocator<void, alloc_t>);
+  static_assert(_uses_allocator<fn::pack<int, std::pmr::string>, alloc_t>);
+  static_assert(not _uses_allocator<fn::pack<int, std::pmr::string &>, alloc_t>);
+  static_assert(not _uses_allocator<fn::pack<>, alloc_t>);
+
+  static_assert(std::uses_allocator_v<fn::copack<int, std::pmr::string>, alloc_t>);
+  static_assert(not std::uses_allocator_v<fn::copack<int, Timeout>, alloc_t>);
+  static_assert(std::uses_allocator_v<fn::expected<std::pmr::string, Error>, alloc_t>);
+  static_assert(std::uses_allocator_v<fn::expected<int, std::pmr::string>, alloc_t>);
+  static_assert(std::uses_allocator_v<fn::expected<void, fn::copack_for<std::pmr::string, Timeout>>, alloc_t>);
+  static_assert(std::uses_allocator_v<fn::expected<fn::pack<int, std::pmr::string>, Error>, alloc_t>);
+  static_assert(not std::uses_allocator_v<fn::expected<int, Error>, alloc_t>);
+  static_assert(std::uses_allocator_v<fn::optional<std::pmr::string>, alloc_t>);
+  static_assert(not std::uses_allocator_v<fn::optional<int>, alloc_t>);
+  static_assert(not std::uses_allocator_v<fn::optional<std::pmr::string &>, alloc_t>);
+  SUCCEED();
+}
+
+TEST_CASE("uses-allocator construction", "[uses_allocator][expected][optional][copack][pack]")
+{
+  std::array<std::byte, 16384> buffer;
+  std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+  alloc_t const a{&arena};
+  no_default_resource const guard;
+
+  SECTION("expected")
+  {
+    using operand_t = fn::expected<std::pmr::string, Error>;
+    std::pmr::vector<operand_t> v{a};
+    v.emplace_back(std::in_place, text);
+    v.emplace_back(fn::unexpect, Error::Bad);
+    v.push_back(v.front());
+    v.resize(4);
+    REQUIRE(resource_of(*v[0]) == &arena);
+    REQUIRE(v[1].error() == Error::Bad);
+    REQUIRE(resource_of(*v[2]) == &arena);
+    REQUIRE(*v[2] == text);
+    REQUIRE(resource_of(*v[3]) == &arena);
+
+    operand_t const moved{std::allocator_arg, a, operand_t{std::allocator_arg, a, std::in_place, text}};
+    REQUIRE(resource_of(*moved) == &arena);
+    REQUIRE(*moved == text);
+  }
+
+  SECTION("expected error")
+  {
+    using operand_t = fn::expected<int, std::pmr::string>;
+    std::pmr::vector<operand_t> v{a};
+    v.emplace_back(1);
+    v.emplace_back(fn::unexpect, text);
+    v.push_back(v.back());
+    REQUIRE(v[0].value() == 1);
+    REQUIRE(resource_of(v[1].error()) == &arena);
+    REQUIRE(resource_of(v[2].error()) == &arena);
+
+    using void_t = fn::expected<void, std::pmr::string>;
+    std::pmr::vector<void_t> w{a};
+    w.emplace_back();
+    w.emplace_back(fn::unexpect, text);
+    w.push_back(w.back());
+    REQUIRE(w[0].has_value());
+    REQUIRE(resource_of(w[2].error()) == &arena);
+  }
+
+  SECTION("copack")
+  {
+    using error = fn::copack_for<std::pmr::string, Timeout>;
+    std::pmr::vector<error> v{a};
+    v.emplace_back(std::in_place_type<std::pmr::string>, text);
+    v.emplace_back(Timeout{5});
+    v.push_back(v.front());
+    REQUIRE(resource_of(*v[0].get_ptr<std::pmr::string>()) == &arena);
+    REQUIRE(v[1] == error{Timeout{5}});
+    REQUIRE(resource_of(*v[2].get_ptr<std::pmr::string>()) == &arena);
+
+    // And a copack error side of an expected
+    using operand_t = fn::expected<int, error>;
+    std::pmr::vector<operand_t> w{a};
+    w.emplace_back(fn::unexpect, std::in_place_type<std::pmr::string>, text);
+    w.push_back(w.back());
+    REQUIRE(resource_of(*w[1].error().get_ptr<std::pmr::string>()) == &arena);
+  }
+
+  SECTION("pack value")
+  {
+    using operand_t = fn::expected<fn::pack<int, std::pmr::string>, Error>;
+    std::pmr::vector<operand_t> v{a};
+    v.emplace_back(std::in_place, 1, text);
+    v.push_back(v.front());
+    REQUIRE(resource_of(get<1>(*v[0])) == &arena);
+    REQUIRE(resource_of(get<1>(*v[1])) == &arena);
+    REQUIRE(get<0>(*v[1]) == 1);
+  }
+
+  SECTION("optional")
+  {
+    using operand_t = fn::optional<std::pmr::string>;
+    std::pmr::vector<operand_t> v{a};
+    v.emplace_back(std::in_place, text);
+    v.emplace_back(std::nullopt);
+    v.push_back(v.front());
+    v.resize(4);
+    REQUIRE(resource_of(*v[0]) == &arena);
+    REQUIRE(not v[1].has_value());
+    REQUIRE(resource_of(*v[2]) == &arena);
+    REQUIRE(not v[3].has_value());
+  }
+
+  SECTION("pipeline out of one arena")
+  {
+    using operand_t = fn::expected<std::pmr::string, Error>;
+    auto const r = operand_t{std::allocator_arg, a, std::in_place, text} //
+                   | fn::and_then([&a](std::pmr::string const &s) -> operand_t {
+                       return operand_t{std::allocator_arg, a, std::in_place, std::string_view{s}.substr(1)};
+                     });
+    REQUIRE(resource_of(*r) == &arena);
+    REQUIRE(*r == text.substr(1));
+  }
+}
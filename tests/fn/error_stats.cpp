@@ -0,0 +1,108 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/error_stats.hpp>
+#include <fn/functor.hpp>
+#include <fn/transform.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+struct Timeout final {};
+struct Refused final {};
+struct Missing final {};
+} // namespace
+
+TEST_CASE("error_stats", "[error_stats][count_errors][expected]")
+{
+  using namespace fn;
+  using E = copack_for<Timeout, Refused, Missing>;
+  using operand_t = expected<int, E>;
+
+  static_assert(error_stats<E>::size == 3);
+  static_assert(alignof(error_stats<E>) >= 64);
+  static_assert(not std::is_copy_constructible_v<error_stats<E>>);
+
+  error_stats<E> stats;
+
+  SECTION("record by the discriminant")
+  {
+    stats.record(E{Refused{}});
+    stats.record(E{Refused{}});
+    stats.record(E{Missing{}});
+    REQUIRE(stats.count<Refused>() == 2);
+    REQUIRE(stats.count<Missing>() == 1);
+    REQUIRE(stats.count<Timeout>() == 0);
+    REQUIRE(stats.count(E{Refused{}}.index) == 2);
+
+    auto const snapshot = stats.snapshot();
+    static_assert(std::is_same_v<decltype(snapshot), std::array<std::uint64_t, 3> const>);
+    REQUIRE(snapshot[E{Refused{}}.index] == 2);
+    REQUIRE(stats.reset() == snapshot);
+    REQUIRE(stats.snapshot() == std::array<std::uint64_t, 3>{});
+  }
+
+  SECTION("count_errors")
+  {
+    auto const step = count_errors(stats);
+    static_assert(std::is_same_v<decltype(step), functor<count_errors_t, error_stats<E> &> const>);
+
+    operand_t const error{unexpect, Timeout{}};
+    static_assert(std::is_same_v<decltype(error | step), operand_t const &>);
+    static_assert(noexcept(error | step));
+    REQUIRE(&(error | step) == &error);
+    REQUIRE(stats.count<Timeout>() == 1);
+
+    auto const r = operand_t{1} | count_errors(stats) | transform([](int i) { return i + 1; });
+    REQUIRE(r.value() == 2);
+    REQUIRE(stats.count<Timeout>() + stats.count<Refused>() + stats.count<Missing>() == 1);
+
+    (void)(operand_t{unexpect, Missing{}} | count_errors(stats));
+    REQUIRE(stats.count<Missing>() == 1);
+  }
+
+  SECTION("constraints")
+  {
+    using step_t = functor<count_errors_t, error_stats<E> &>;
+    static_assert(monadic_invocable<count_errors_t, operand_t, error_stats<E> &>);
+    static_assert(not monadic_invocable<count_errors_t, expected<int, copack<Timeout>>, error_stats<E> &>);
+    static_assert(not monadic_invocable<count_errors_t, optional<int>, error_stats<E> &>);
+    static_assert(std::is_invocable_v<count_errors_t const &, error_stats<E> &>);
+    static_assert(not std::is_invocable_v<count_errors_t const &, error_stats<E>>);
+    static_assert(sizeof(step_t) == sizeof(void *));
+  }
+
+  SECTION("contention")
+  {
+    // Every increment is counted once, however many threads record at the same time
+    constexpr int threads = 32;
+    constexpr int iterations = 10000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+      workers.emplace_back([&stats, t] {
+        auto const step = count_errors(stats);
+        for (int i = 0; i < iterations; ++i) {
+          if (t % 2 == 0)
+            (void)(operand_t{unexpect, Refused{}} | step);
+          else
+            (void)(operand_t{unexpect, Timeout{}} | step);
+        }
+      });
+    std::uint64_t taken = 0;
+    for (int i = 0; i < 100; ++i)
+      for (auto const c : stats.reset())
+        taken += c;
+    for (auto &w : workers)
+      w.join();
+    for (auto const c : stats.reset())
+      taken += c;
+    REQUIRE(taken == std::uint64_t{threads} * iterations);
+  }
+}
@@ -4384,3 +4384,19 @@ TEST_CASE("expected with empty copack side", "[expected][copack]")
     }
   }
 }
+
+TEST_CASE("expected copack layout", "[expected][copack][layout]")
+{
+  // a copack error of small alternatives takes no more than the alternatives, its index and the
+  // flag of the expected, each at its natural alignment - there is no word-sized discriminant
+  using E = fn::copack_for<Error, Xint>;
+  static_assert(sizeof(fn::expected<int, E>) == 3 * sizeof(int));
+  static_assert(sizeof(fn::expected<char, fn::copack_for<char, bool>>) == 3);
+  static_assert(sizeof(fn::expected<void, E>) == 3 * sizeof(int));
+
+  constexpr fn::expected<int, E> e{fn::unexpect, Xint{3}};
+  static_assert(not e.has_value());
+  static_assert(e.error().has_value<Xint>());
+  static_assert(fn::expected<int, E>{5}.value() == 5);
+  SUCCEED();
+}
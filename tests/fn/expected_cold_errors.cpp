@@ -0,0 +1,12 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+// Run the fn::expected suite again in the LIBFN_COLD_ERRORS mode, which moves the error side of
+// the value-side operations out of line. The mode changes code generation only, so every result,
+// type and noexcept the suite asserts - the constexpr ones included - must hold unchanged.
+
+#define LIBFN_COLD_ERRORS
+
+#include "fn/expected.cpp"
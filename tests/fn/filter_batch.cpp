@@ -0,0 +1,124 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/filter.hpp>
+#include <fn/filter_batch.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+enum class Error { Negative, Odd };
+
+// Counts how often it is rebuilt
+struct Counted final {
+  int v;
+  int copies = 0;
+  constexpr Counted(int i) : v(i) {}
+  constexpr Counted(Counted const &o) : v(o.v), copies(o.copies + 1) {}
+  constexpr Counted(Counted &&o) noexcept : v(o.v), copies(o.copies + 1) {}
+  constexpr Counted &operator=(Counted const &) = default;
+  constexpr Counted &operator=(Counted &&) noexcept = default;
+};
+} // namespace
+
+TEST_CASE("filter_batch", "[filter_batch][filter][expected][optional]")
+{
+  using namespace fn;
+  using operand_t = expected<int, Error>;
+  auto const non_negative = [](int i) { return i >= 0; };
+  auto const negative = [](int) { return Error::Negative; };
+
+  SECTION("expected")
+  {
+    std::vector<operand_t> v{1, -2, unexpected(Error::Odd), 3, -4};
+    REQUIRE(filter_batch(std::span{v}, non_negative, negative) == 2);
+    REQUIRE(v[0].value() == 1);
+    REQUIRE(v[1].error() == Error::Negative);
+    REQUIRE(v[2].error() == Error::Odd); // holding no value, not touched
+    REQUIRE(v[3].value() == 3);
+    REQUIRE(v[4].error() == Error::Negative);
+
+    // the handler consumes the value refused
+    std::vector<expected<std::string, std::string>> s{std::string{"ok"}, std::string{"bad"}};
+    auto const keep_ok = [](std::string const &s) { return s == "ok"; };
+    REQUIRE(filter_batch(s, keep_ok, [](std::string &&s) { return s + "!"; }) == 1);
+    REQUIRE(s[1].error() == "bad!");
+  }
+
+  SECTION("optional")
+  {
+    std::vector<optional<float>> v{1.5f, -2.0f, {}, 0.0f};
+    REQUIRE(filter_batch(std::span{v}, [](float f) { return f >= 0.0f; }) == 1);
+    REQUIRE(v[0].value() == 1.5f);
+    REQUIRE(not v[1].has_value());
+    REQUIRE(not v[2].has_value());
+    REQUIRE(v[3].value() == 0.0f);
+  }
+
+  SECTION("only the carriers refused are rebuilt")
+  {
+    std::vector<expected<Counted, Error>> v;
+    v.reserve(3);
+    v.emplace_back(std::in_place, 1);
+    v.emplace_back(std::in_place, -1);
+    v.emplace_back(std::in_place, 2);
+    int const copies = v[0].value().copies;
+    REQUIRE(filter_batch(v, [](Counted const &c) { return c.v >= 0; }, [](Counted &&) { return Error::Negative; })
+            == 1);
+    REQUIRE(v[0].value().copies == copies);
+    REQUIRE(v[1].error() == Error::Negative);
+    REQUIRE(v[2].value().copies == copies);
+  }
+
+  SECTION("the same as filter, over one million elements")
+  {
+    // Across many chunks, and a last one partly filled
+    constexpr std::size_t size = 1'000'000 + 17;
+    std::vector<operand_t> batch;
+    batch.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      int const n = static_cast<int>(i % 7) - 3;
+      if (i % 11 == 0)
+        batch.emplace_back(unexpected(Error::Odd));
+      else
+        batch.emplace_back(n);
+    }
+    std::vector<operand_t> each = batch;
+    std::size_t refused = 0;
+    for (auto &e : each) {
+      bool const was = e.has_value();
+      e = e | filter(non_negative, negative);
+      refused += was && not e.has_value() ? 1 : 0;
+    }
+
+    REQUIRE(filter_batch(batch, non_negative, negative) == refused);
+    REQUIRE(batch == each);
+  }
+
+  SECTION("constant evaluation")
+  {
+    constexpr auto fn = [] {
+      std::vector<operand_t> v{1, -2, 3};
+      return filter_batch(v, [](int i) { return i > 0; }, [](int) { return Error::Negative; }) * 10
+             + (v[1].has_value() ? 0 : 1);
+    };
+    static_assert(fn() == 11);
+  }
+
+  // The carriers are filtered where they are stored
+  static_assert(std::is_invocable_v<filter_batch_t const &, std::span<operand_t>, decltype(non_negative),
+                                    decltype(negative)>);
+  static_assert(not std::is_invocable_v<filter_batch_t const &, std::span<operand_t const>,
+                                        decltype(non_negative), decltype(negative)>);
+  static_assert(not std::is_invocable_v<filter_batch_t const &, std::span<operand_t>, decltype(non_negative)>);
+  static_assert(not std::is_invocable_v<filter_batch_t const &, std::span<optional<int>>, decltype(non_negative),
+                                        decltype(negative)>);
+}
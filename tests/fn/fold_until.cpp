@@ -0,0 +1,149 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/fold_until.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+enum class Error { Negative, Overflow };
+
+constexpr auto add = [](int acc, int v) -> fn::expected<int, Error> {
+  if (v < 0)
+    return fn::unexpected(Error::Negative);
+  return acc + v;
+};
+
+struct Counted final {
+  int copies = 0;
+  int steps = 0;
+  constexpr Counted() = default;
+  constexpr Counted(Counted &&) noexcept = default;
+  constexpr Counted(Counted const &o) : copies(o.copies + 1), steps(o.steps) {}
+  constexpr Counted &operator=(Counted &&) noexcept = default;
+  constexpr Counted &operator=(Counted const &o)
+  {
+    copies = o.copies + 1;
+    steps = o.steps;
+    return *this;
+  }
+};
+} // namespace
+
+TEST_CASE("fold_until", "[fold_until][expected][optional]")
+{
+  using namespace fn;
+
+  SECTION("expected")
+  {
+    constexpr std::array<int, 4> values{1, 2, 3, 4};
+    using T = decltype(fold_until(values, 0, add));
+    static_assert(std::is_same_v<T, expected<int, Error>>);
+    static_assert(fold_until(values, 0, add).value() == 10);
+    REQUIRE(fold_until(values, 0, add).value() == 10);
+
+    SECTION("empty range returns the initial accumulator")
+    {
+      std::vector<int> const empty;
+      REQUIRE(fold_until(empty, 5, add).value() == 5);
+    }
+
+    SECTION("first failure stops the fold")
+    {
+      int visited = 0;
+      auto const step = [&visited](int acc, int v) -> expected<int, Error> {
+        ++visited;
+        return add(acc, v);
+      };
+      std::array<int, 4> const mixed{1, -2, 3, -4};
+      auto const r = fold_until(mixed, 0, step);
+      REQUIRE(r.error() == Error::Negative);
+      REQUIRE(visited == 2);
+    }
+
+    SECTION("copack error is kept as the step returns it")
+    {
+      using error_t = copack_for<Error, std::string>;
+      auto const step = [](int acc, int v) -> expected<int, error_t> {
+        if (v > 100)
+          return unexpected<error_t>{std::string{"too big"}};
+        return acc + v;
+      };
+      std::array<int, 2> const big{1, 200};
+      auto const r = fold_until(big, 0, step);
+      static_assert(std::is_same_v<decltype(r), expected<int, error_t> const>);
+      REQUIRE(r.error() == error_t{std::string{"too big"}});
+    }
+
+    SECTION("step value converts into the accumulator")
+    {
+      auto const step = [](long acc, int v) -> expected<int, Error> { return static_cast<int>(acc) + v; };
+      static_assert(std::is_same_v<decltype(fold_until(values, 0L, step)), expected<long, Error>>);
+      REQUIRE(fold_until(values, 0L, step).value() == 10L);
+    }
+  }
+
+  SECTION("optional")
+  {
+    constexpr auto halve = [](int acc, int v) -> optional<int> {
+      if (v % 2 != 0)
+        return {};
+      return acc + v / 2;
+    };
+    constexpr std::array<int, 3> even{2, 4, 6};
+    static_assert(std::is_same_v<decltype(fold_until(even, 0, halve)), optional<int>>);
+    static_assert(fold_until(even, 0, halve).value() == 6);
+    std::array<int, 3> const odd{2, 3, 6};
+    REQUIRE(not fold_until(odd, 0, halve).has_value());
+  }
+
+  SECTION("accumulator is moved, never copied")
+  {
+    constexpr auto step = [](Counted acc, int) -> expected<Counted, Error> {
+      ++acc.steps;
+      return acc;
+    };
+    constexpr std::array<int, 3> values{1, 2, 3};
+    constexpr auto r = fold_until(values, Counted{}, step);
+    static_assert(r.value().steps == 3);
+    static_assert(r.value().copies == 0);
+  }
+
+  SECTION("container accumulator reserves")
+  {
+    auto const step = [](std::vector<int> acc, int v) -> expected<std::vector<int>, Error> {
+      acc.push_back(v * v);
+      return acc;
+    };
+    std::array<int, 3> const values{1, 2, 3};
+    auto const r = fold_until(values, std::vector<int>{}, step, 64);
+    REQUIRE(r.value() == std::vector<int>{1, 4, 9});
+    REQUIRE(r.value().capacity() >= 64);
+  }
+
+  SECTION("constraints")
+  {
+    constexpr auto bare = [](int acc, int v) { return acc + v; };
+    constexpr auto to_void = [](int, int) -> expected<void, Error> { return {}; };
+    static_assert(foldable_until<std::array<int, 1> const &, int, decltype(add) const>);
+    static_assert(not foldable_until<std::array<int, 1> const &, int, decltype(bare) const>);
+    static_assert(not foldable_until<std::array<int, 1> const &, int, decltype(to_void) const>);
+    static_assert(not foldable_until<int, int, decltype(add) const>);
+  }
+
+  SECTION("noexcept")
+  {
+    constexpr auto nothrow = [](int acc, int v) noexcept -> expected<int, Error> { return acc + v; };
+    std::array<int, 1> const values{1};
+    static_assert(noexcept(fold_until(values, 0, nothrow)));
+    static_assert(not noexcept(fold_until(values, 0, add)));
+  }
+}
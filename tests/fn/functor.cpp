@@ -6,6 +6,10 @@
 #include "util/static_check.hpp"
 
 #include <fn/functor.hpp>
+#include <fn/inspect_error.hpp>
+#include <fn/or_else.hpp>
+#include <fn/transform.hpp>
+#include <fn/transform_error.hpp>
 
 #include <catch2/catch_all.hpp>
 
@@ -89,6 +93,15 @@ constexpr inline struct nothrow_t final {
     }
   };
 } nothrow_verb = {};
+
+// Instantiating this callable for any argument is a dependent hard error: a pipeline that compiles
+// while holding it provably never instantiates the step
+struct Poison final {
+  template <typename T> constexpr void operator()(T &&) const { static_assert(sizeof(T) == 0); }
+};
+
+template <typename V, typename P>
+constexpr bool pipes = requires(V &&v, P &&p) { FWD(v) | FWD(p); };
 } // namespace
 
 TEST_CASE("user-defined monadic operation", "[functor]")
@@ -138,3 +151,82 @@ TEST_CASE("pipeline noexcept", "[functor][noexcept]")
   static_assert(not noexcept(std::declval<O &&>() | throwing(fn1)));
   SUCCEED();
 }
+
+TEST_CASE("functor composition", "[functor][pipeline]")
+{
+  constexpr auto fn3 = [](int i) constexpr -> int { return i * 3; };
+
+  // steps compose before any carrier arrives, and the composition stores them flat
+  auto const p = dummy(fn1) | nothrow_verb(fn3);
+  using P = std::remove_cvref_t<decltype(p)>;
+  static_assert(fn::some_functor<P>);
+  static_assert(std::is_same_v<P::functor_type, fn::pipeline_t>);
+  static_assert(P::size == 2);
+  static_assert(decltype(p | p)::size == 4);
+  static_assert(decltype(p | dummy(fn1))::size == 3);
+  static_assert(decltype(dummy(fn1) | p)::size == 3);
+
+  CHECK((fn::optional{4} | p).value() == 15);
+  CHECK((fn::expected<int, bool>{4} | p).value() == 15);
+  CHECK((fn::optional{4} | (p | p)).value() == 48);
+  CHECK(not(fn::optional<int>{} | p).has_value());
+
+  // the same result as the steps piped one at a time
+  static_assert(
+      std::is_same_v<decltype(fn::optional{4} | p), decltype(fn::optional{4} | dummy(fn1) | nothrow_verb(fn3))>);
+
+  // a chain any step of which does not accept its predecessor's result is not applicable
+  static_assert(pipes<fn::optional<int>, P const &>);
+  static_assert(not pipes<fn::optional<int>, decltype(dummy(fn1) | dummy(fn2))>);
+
+  SECTION("noexcept")
+  {
+    using O = fn::optional<int>;
+    static_assert(noexcept(std::declval<O &>() | (nothrow_verb(fn1) | nothrow_verb(fn3))));
+    static_assert(not noexcept(std::declval<O &>() | (nothrow_verb(fn1) | throwing(fn3))));
+    static_assert(not noexcept(std::declval<O &>() | (throwing(fn1) | nothrow_verb(fn3))));
+    SUCCEED();
+  }
+}
+
+TEST_CASE("reusable pipeline", "[functor][pipeline]")
+{
+  constexpr auto fn3 = [](int i) constexpr -> int { return i * 3; };
+
+  // built once, applied to any number of carriers
+  auto const p = fn::pipeline(dummy(fn1), nothrow_verb(fn3), dummy(fn1));
+  using P = std::remove_cvref_t<decltype(p)>;
+  static_assert(std::is_same_v<P::functor_type, fn::pipeline_t>);
+  static_assert(P::size == 3);
+  for (int i = 0; i < 3; ++i)
+    CHECK((fn::optional{i} | p).value() == (i + 1) * 3 + 1);
+
+  // a pipeline step contributes its own steps, so pipelines nest flat
+  static_assert(decltype(fn::pipeline(p, dummy(fn1), p))::size == 7);
+  static_assert(decltype(fn::pipeline(dummy(fn1)))::size == 1);
+  CHECK((fn::optional{1} | fn::pipeline(dummy(fn1))).value() == 2);
+  CHECK((fn::optional{1} | fn::pipeline(p, p)).value() == 25);
+  static_assert(std::is_same_v<decltype(fn::pipeline(p, p)), decltype(p | p)>);
+
+  SECTION("infallible steps drop the error side")
+  {
+    // behind a step which cannot fail, an error-side step is not run - nor is its callback instantiated
+    using E = fn::expected<int, fn::copack<>>;
+    constexpr auto p = fn::pipeline(fn::transform(fn3), fn::or_else(Poison{}), fn::transform_error(Poison{}),
+                                    fn::inspect_error(Poison{}), fn::transform(fn1));
+    static_assert(std::is_same_v<decltype(E{2} | p), E>);
+    CHECK((E{2} | p).value() == 7);
+    static_assert((E{2} | p).value() == 7);
+    constexpr auto id = [](int i) noexcept { return i; };
+    static_assert(noexcept(E{2} | fn::pipeline(fn::or_else(Poison{}), fn::transform(id))));
+    SUCCEED();
+  }
+
+  SECTION("constexpr")
+  {
+    constexpr auto q = fn::pipeline(fn::transform(fn1), fn::transform(fn3));
+    static_assert((fn::optional{1} | q).value() == 6);
+    static_assert((fn::expected<int, bool>{1} | q | q).value() == 21);
+    SUCCEED();
+  }
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+// The LIBFN_INSPECT_LEVEL threshold is chosen for a whole program, as LIBFN_TRACE is
+#define LIBFN_INSPECT_LEVEL 2
+
+#include <fn/functor.hpp>
+#include <fn/inspect_at.hpp>
+#include <fn/transform.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace {
+enum class Error { Bad };
+
+// Instantiating this callable for any argument is a dependent hard error: a step that compiles
+// while receiving it provably never instantiates its callback.
+struct Poison final {
+  template <typename T> constexpr void operator()(T &&) const { static_assert(sizeof(T) == 0); }
+};
+} // namespace
+
+TEST_CASE("inspect_at", "[inspect_at][inspect][inspect_error]")
+{
+  using namespace fn;
+  using operand_t = expected<int, Error>;
+  static_assert(inspect_level == 2);
+
+  int seen = 0;
+  std::string const captured(64, 'x'); // a capture the enabled step carries
+  auto const observe = [&seen, captured](int i) { seen += i + static_cast<int>(captured.size()) * 0; };
+  auto const observe_error = [&seen](Error) { seen = -1; };
+
+  SECTION("at or above the level, the wrapped verb")
+  {
+    static_assert(std::is_same_v<decltype(inspect_at<2>(observe)), decltype(inspect(observe))>);
+    static_assert(std::is_same_v<decltype(inspect_error_at<3>(observe_error)), decltype(inspect_error(observe_error))>);
+
+    operand_t const a{5};
+    REQUIRE(&(a | inspect_at<2>(observe)) == &a);
+    REQUIRE(seen == 5);
+    REQUIRE((operand_t{unexpected(Error::Bad)} | inspect_error_at<2>(observe_error)).error() == Error::Bad);
+    REQUIRE(seen == -1);
+  }
+
+  SECTION("below the level, the identity")
+  {
+    // no state: the callback and its captures are not stored
+    using step_t = decltype(inspect_at<1>(observe));
+    static_assert(std::is_same_v<step_t, functor<inspect_at_t<1, inspect_t>>>);
+    static_assert(step_t::size == 0 && sizeof(step_t) == 1 && std::is_trivially_copyable_v<step_t>);
+    static_assert(decltype(inspect_error_at<0>(observe_error))::size == 0);
+
+    // nor instantiated, the operand returned as it came, without an exception edge
+    operand_t a{5};
+    static_assert(std::is_same_v<decltype(a | inspect_at<1>(Poison{})), operand_t &>);
+    static_assert(std::is_same_v<decltype(std::move(a) | inspect_at<1>(Poison{})), operand_t &&>);
+    static_assert(noexcept(a | inspect_at<1>(Poison{})));
+    REQUIRE(&(a | inspect_at<1>(observe)) == &a);
+    REQUIRE(&(a | inspect_error_at<1>(Poison{})) == &a);
+    REQUIRE(seen == 0);
+
+    // and a pipeline does not run it at all
+    using V = operand_t &&;
+    using S = decltype(inspect_at<0>(Poison{}));
+    using T = decltype(transform([](int i) { return i + 1; }));
+    static_assert(detail::_pipeline<V, S, T>::skip);
+    auto const p = pipeline(inspect_at<0>(Poison{}), transform([](int i) { return i + 1; }));
+    REQUIRE((operand_t{1} | p).value() == 2);
+
+    // in constant evaluation too
+    constexpr auto fn = [] { return (operand_t{3} | inspect_at<1>(Poison{})).value(); };
+    static_assert(fn() == 3);
+  }
+
+  SECTION("gated by a flag")
+  {
+    std::atomic<bool> flag = false;
+    auto const gated = inspect_at<2>(flag, observe);
+    static_assert(decltype(gated)::size == 2);
+
+    operand_t const a{5};
+    REQUIRE(&(a | gated) == &a);
+    REQUIRE(seen == 0);
+    flag.store(true, std::memory_order_relaxed);
+    REQUIRE((a | gated).value() == 5);
+    REQUIRE(seen == 5);
+    REQUIRE((operand_t{unexpected(Error::Bad)} | inspect_error_at<3>(flag, observe_error)).error() == Error::Bad);
+    REQUIRE(seen == -1);
+
+    // below the level, the identity as well, never loading the flag
+    static_assert(std::is_same_v<decltype(inspect_at<1>(flag, Poison{})), functor<inspect_at_t<1, inspect_t>>>);
+    REQUIRE(&(a | inspect_at<1>(flag, Poison{})) == &a);
+  }
+}
@@ -0,0 +1,191 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/optional.hpp>
+#include <fn/optional_niche.hpp>
+#include <fn/utility.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+enum class Color : unsigned char { red, green, blue, none };
+enum class Plain : unsigned char { a, b };
+
+struct Timeout final {
+  int ms;
+  constexpr bool operator==(Timeout const &) const noexcept = default;
+};
+struct Refused final {
+  int code;
+  constexpr bool operator==(Refused const &) const noexcept = default;
+};
+
+using Failure = fn::copack_for<Timeout, Refused>;
+
+// Throws when built from a negative number, leaving whatever it wrote behind
+struct Checked final {
+  int v;
+  constexpr Checked(int i) : v(i)
+  {
+    if (i < 0) {
+      v = -1;
+      throw std::runtime_error("negative");
+    }
+  }
+};
+} // namespace
+
+template <> struct fn::optional_niche<Color> : fn::optional_sentinel<Color::none> {};
+// The copack niche is opted into
+template <> struct fn::optional_niche<Failure> : fn::optional_copack_niche<Failure> {};
+template <> struct fn::optional_niche<Checked> {
+  static constexpr auto empty() noexcept -> Checked { return Checked{0x7fff'ffff}; }
+  static constexpr bool is_empty(Checked const &c) noexcept { return c.v == 0x7fff'ffff; }
+};
+
+TEST_CASE("optional niche layout", "[optional][optional_niche]")
+{
+  using namespace fn;
+  using E = copack_for<Timeout, Refused>;
+
+  static_assert(has_optional_niche<Color>);
+  static_assert(has_optional_niche<E>);
+  static_assert(not has_optional_niche<Plain>);
+  static_assert(not has_optional_niche<int>);
+  static_assert(not has_optional_niche<copack_for<std::string, int>>); // not trivially copyable
+  static_assert(not has_optional_niche<copack<Refused>>);              // trivially copyable, not opted in
+  static_assert(not has_optional_niche<std::string_view>);             // no niche to declare
+
+  static_assert(sizeof(optional<Color>) == sizeof(Color));
+  static_assert(sizeof(optional<E>) == sizeof(E));
+  static_assert(sizeof(optional<Checked>) == sizeof(Checked));
+  static_assert(sizeof(optional<Plain>) == 2 * sizeof(Plain)); // the engaged flag, as before
+  static_assert(sizeof(optional<int &>) == sizeof(int *));     // a bare pointer, as before
+  static_assert(sizeof(optional<copack<Refused>>) > sizeof(copack<Refused>));
+  static_assert(sizeof(optional<std::string_view>) > sizeof(std::string_view));
+
+  // Exactly as trivial as without a niche
+  static_assert(std::is_trivially_copyable_v<optional<Color>>);
+  static_assert(std::is_trivially_copyable_v<optional<E>>);
+  static_assert(std::is_trivially_destructible_v<optional<E>>);
+  SUCCEED();
+}
+
+TEST_CASE("optional niche of an enum", "[optional][optional_niche]")
+{
+  using namespace fn;
+  using operand_t = optional<Color>;
+
+  constexpr operand_t empty{};
+  static_assert(not empty.has_value());
+  static_assert(empty.value_or(Color::blue) == Color::blue);
+  static_assert(operand_t{Color::red}.value() == Color::red);
+  static_assert(operand_t{std::nullopt} == empty);
+  static_assert(operand_t{Color::green} == Color::green);
+  static_assert(operand_t{Color::green} != empty);
+
+  operand_t a{Color::red};
+  REQUIRE(a.has_value());
+  REQUIRE(a.begin() + 1 == a.end());
+  a = std::nullopt;
+  REQUIRE(not a.has_value());
+  REQUIRE(a.begin() == a.end());
+  REQUIRE_THROWS_AS(a.value(), std::bad_optional_access);
+  a = Color::blue;
+  REQUIRE(*a == Color::blue);
+  REQUIRE(a.emplace(Color::green) == Color::green);
+
+  operand_t b{};
+  a.swap(b);
+  REQUIRE(not a.has_value());
+  REQUIRE(b.value() == Color::green);
+  a.swap(b);
+  REQUIRE(a.value() == Color::green);
+  REQUIRE(not b.has_value());
+
+  auto const t = a.transform([](Color c) { return c == Color::green ? 1 : 0; });
+  static_assert(std::is_same_v<decltype(t), optional<int> const>);
+  REQUIRE(t.value() == 1);
+  REQUIRE(b.or_else([] { return operand_t{Color::red}; }).value() == Color::red);
+  REQUIRE(a.and_then([](Color) { return operand_t{}; }) == std::nullopt);
+}
+
+TEST_CASE("optional niche of a copack", "[optional][optional_niche][copack]")
+{
+  using namespace fn;
+  using E = copack_for<Timeout, Refused>;
+  using operand_t = optional<E>;
+
+  static_assert(not operand_t{}.has_value());
+  static_assert(operand_t{E{Refused{3}}}.has_value());
+  static_assert(operand_t{E{Refused{3}}}->has_value<Refused>());
+  static_assert(not optional_niche<E>::is_empty(E{Timeout{1}}));
+
+  // The graded operations work over the niche exactly as over the flag
+  operand_t const v{E{Timeout{5}}};
+  auto const r = v.and_then(overload([](Timeout t) { return optional<int>{t.ms}; },
+                                     [](Refused r) { return optional<int>{-r.code}; }));
+  REQUIRE(r.value() == 5);
+  REQUIRE(v.and_then([](auto) { return optional<int>{}; }) == std::nullopt);
+  REQUIRE(operand_t{}.or_else([] { return operand_t{E{Refused{1}}}; })->has_value<Refused>());
+
+  // A narrower copack widens into it
+  optional<copack<Refused>> const narrow{copack<Refused>{Refused{2}}};
+  operand_t const wide = narrow;
+  REQUIRE(wide->has_value<Refused>());
+  operand_t const none = optional<copack<Refused>>{};
+  REQUIRE(not none.has_value());
+}
+
+TEST_CASE("optional niche exception safety", "[optional][optional_niche]")
+{
+  using namespace fn;
+  using operand_t = optional<Checked>;
+
+  operand_t a{1};
+  REQUIRE_THROWS_AS(a.emplace(-5), std::runtime_error);
+  REQUIRE(not a.has_value()); // not engaged with what the constructor left behind
+
+  operand_t b{};
+  REQUIRE_THROWS_AS(b = Checked{-1}, std::runtime_error); // the temporary throws, b is untouched
+  REQUIRE(not b.has_value());
+  b = 7;
+  REQUIRE(b->v == 7);
+}
+
+TEST_CASE("optional niche in a vector", "[optional][optional_niche]")
+{
+  // A vector of optionals with a niche takes as much memory as a vector of the values, and the
+  // empty state is found by the same scan
+  using namespace fn;
+  constexpr std::size_t count = 4096;
+  std::vector<optional<Color>> niche(count);
+  std::vector<optional<Plain>> flagged(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i % 3 != 0) {
+      niche[i] = static_cast<Color>(i % 3);
+      flagged[i] = static_cast<Plain>(i % 2);
+    }
+  }
+  static_assert(sizeof(optional<Color>) * 2 == sizeof(optional<Plain>));
+  REQUIRE(niche.size() * sizeof(niche[0]) == count * sizeof(Color));
+
+  std::size_t engaged = 0;
+  std::size_t green = 0;
+  for (auto const &o : niche) {
+    engaged += o.has_value() ? 1 : 0;
+    green += o == Color::green ? 1 : 0;
+  }
+  REQUIRE(engaged == count - (count + 2) / 3);
+  REQUIRE(green == count / 3);
+}
@@ -0,0 +1,196 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/par_conjoin.hpp>
+#include <fn/transform.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+enum class Error { Missing, Cancelled };
+
+struct Inline final {
+  void execute(auto &&fn) { fn(); }
+};
+
+struct Failing final {
+  void execute(auto &&) { throw std::runtime_error("full"); }
+};
+} // namespace
+
+TEST_CASE("par_conjoin", "[par_conjoin][conjoin][expected][optional]")
+{
+  using namespace fn;
+  using A = expected<int, copack<Error>>;
+  using B = expected<std::string, std::string>;
+
+  SECTION("result type is that of conjoin")
+  {
+    Inline exec;
+    auto const r = par_conjoin(
+        exec, [] { return A{1}; }, [] { return B{"b"}; }, [] { return A{3}; });
+    using T = decltype(conjoin(A{1}, B{"b"}, A{3}));
+    static_assert(std::is_same_v<decltype(r), T const>);
+    static_assert(std::is_same_v<T, expected<pack<int, std::string, int>, copack_for<Error, std::string>>>);
+    REQUIRE(r.value() == pack{1, std::string{"b"}, 3});
+  }
+
+  SECTION("single task")
+  {
+    Inline exec;
+    REQUIRE(par_conjoin(exec, [] { return A{1}; }).value() == 1);
+  }
+
+  SECTION("leftmost error wins")
+  {
+    // The inline executor runs the tasks it is given at once, so the first task runs last
+    Inline exec;
+    std::vector<int> order;
+    auto const r = par_conjoin(
+        exec,
+        [&] {
+          order.push_back(0);
+          return A{unexpect, Error::Missing};
+        },
+        [&] {
+          order.push_back(1);
+          return B{unexpect, "second"};
+        });
+    REQUIRE(order == std::vector<int>{1, 0});
+    REQUIRE(r.error() == copack_for<Error, std::string>{Error::Missing});
+  }
+
+  SECTION("tasks right of a failure are cancelled")
+  {
+    Inline exec;
+    bool third = false;
+    auto const r = par_conjoin(
+        exec, [] { return A{0}; },
+        [](cancel_token token) {
+          REQUIRE(not token.stop_requested());
+          return A{unexpect, Error::Missing};
+        },
+        [&] {
+          third = true;
+          return A{2};
+        });
+    REQUIRE(not third);
+    REQUIRE(r.error() == copack<Error>{Error::Missing});
+  }
+
+  SECTION("running tasks see the token")
+  {
+    thread_pool pool{3};
+    std::promise<void> started;
+    auto const r = par_conjoin(
+        pool, [] { return A{0}; },
+        [&] {
+          started.get_future().wait();
+          return A{unexpect, Error::Missing};
+        },
+        [&](cancel_token token) {
+          started.set_value();
+          while (not token.stop_requested())
+            std::this_thread::yield();
+          return A{unexpect, Error::Cancelled};
+        });
+    REQUIRE(r.error() == copack<Error>{Error::Missing});
+  }
+
+  SECTION("tasks overlap")
+  {
+    thread_pool pool{2};
+    // Each task waits for the other two to start, so this completes only if all three overlap
+    std::atomic<int> started = 0;
+    auto const task = [&] {
+      started.fetch_add(1);
+      while (started.load() < 3)
+        std::this_thread::yield();
+      return A{started.load()};
+    };
+    auto const r = par_conjoin(pool, task, task, task);
+    REQUIRE(r.value() == pack{3, 3, 3});
+  }
+
+  SECTION("called from a worker of its own executor")
+  {
+    // The only worker is the caller: the tasks it queued on itself are taken up by the call
+    thread_pool pool{1};
+    std::promise<expected<pack<int, int>, copack<Error>>> result;
+    pool.execute([&] { result.set_value(par_conjoin(pool, [] { return A{1}; }, [] { return A{2}; })); });
+    REQUIRE(result.get_future().get().value() == pack{1, 2});
+
+    // Every worker blocked in a call of its own
+    thread_pool two{2};
+    auto const inner = [&two] {
+      return par_conjoin(two, [] { return A{1}; }, [] { return A{2}; }) | transform([](int l, int r) {
+               return l + r;
+             });
+    };
+    std::promise<expected<pack<int, int>, copack<Error>>> outer;
+    two.execute([&] { outer.set_value(par_conjoin(two, inner, inner)); });
+    REQUIRE(outer.get_future().get().value() == pack{3, 3});
+  }
+
+  SECTION("optional")
+  {
+    thread_pool pool{2};
+    auto const some = par_conjoin(
+        pool, [] { return optional<int>{1}; }, [] { return optional<int>{2}; });
+    REQUIRE(some.value() == pack{1, 2});
+    auto const none = par_conjoin(
+        pool, [] { return optional<int>{1}; }, [] { return optional<int>{}; });
+    REQUIRE(not none.has_value());
+  }
+
+  SECTION("exception")
+  {
+    thread_pool pool{2};
+    REQUIRE_THROWS_AS(par_conjoin(
+                          pool, [] { return A{1}; }, []() -> A { throw std::logic_error("task"); }),
+                      std::logic_error);
+    // An error to the left takes precedence over an exception to the right
+    Inline exec;
+    auto const r = par_conjoin(
+        exec, [] { return A{unexpect, Error::Missing}; }, []() -> A { throw std::logic_error("task"); });
+    REQUIRE(r.error() == copack<Error>{Error::Missing});
+  }
+
+  SECTION("executor failure")
+  {
+    Failing exec;
+    bool ran = false;
+    REQUIRE_THROWS_AS(par_conjoin(
+                          exec,
+                          [&] {
+                            ran = true;
+                            return A{1};
+                          },
+                          [] { return A{2}; }),
+                      std::runtime_error);
+    REQUIRE(not ran);
+  }
+
+  SECTION("constraints")
+  {
+    constexpr auto bare = [] { return 1; };
+    constexpr auto carrier = [] { return A{1}; };
+    constexpr auto mixed = [] { return optional<int>{1}; };
+    static_assert(par_conjoinable<decltype(carrier) const &>);
+    static_assert(par_conjoinable<decltype(carrier) const &, decltype(carrier) const &>);
+    static_assert(not par_conjoinable<>);
+    static_assert(not par_conjoinable<decltype(bare) const &>);
+    static_assert(not par_conjoinable<decltype(carrier) const &, decltype(mixed) const &>);
+    REQUIRE(not cancel_token{}.stop_requested());
+  }
+}
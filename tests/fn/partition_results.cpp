@@ -0,0 +1,155 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/boxed.hpp>
+#include <fn/partition_results.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <list>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+enum class Error { Negative, Overflow };
+
+struct Timeout final {
+  int ms;
+  constexpr bool operator==(Timeout const &) const noexcept = default;
+};
+
+struct Counted final {
+  int v = 0;
+  int copies = 0;
+  constexpr Counted(int i) : v(i) {}
+  constexpr Counted(Counted &&o) noexcept = default;
+  constexpr Counted(Counted const &o) : v(o.v), copies(o.copies + 1) {}
+  Counted &operator=(Counted &&) = delete;
+  Counted &operator=(Counted const &) = delete;
+};
+} // namespace
+
+TEST_CASE("partition_results", "[partition_results][expected][copack]")
+{
+  using namespace fn;
+  using error_t = copack_for<Error, Timeout>;
+  using operand_t = expected<int, error_t>;
+
+  std::vector<operand_t> const input{1, unexpected<error_t>{Error::Negative}, 2, unexpected<error_t>{Timeout{5}}, 3,
+                                     unexpected<error_t>{Error::Overflow}};
+
+  SECTION("one column of errors")
+  {
+    auto const r = partition_results(input);
+    static_assert(std::is_same_v<decltype(r), partitioned<std::vector<int>, std::vector<error_t>> const>);
+    REQUIRE(r.values == std::vector<int>{1, 2, 3});
+    REQUIRE(r.errors == std::vector<error_t>{Error::Negative, Timeout{5}, Error::Overflow});
+
+    // Sized by the counting pre-pass
+    REQUIRE(r.values.capacity() == 3);
+    REQUIRE(r.errors.capacity() == 3);
+
+    // Any error type will do
+    std::vector<expected<int, std::string>> const plain{1, unexpected<std::string>{"bad"}};
+    auto const s = partition_results(plain);
+    REQUIRE(s.values == std::vector<int>{1});
+    REQUIRE(s.errors == std::vector<std::string>{"bad"});
+  }
+
+  SECTION("one column of errors per alternative")
+  {
+    auto const r = partition_results(input, by_alternative);
+    using columns_t = pack<std::vector<error_t::select_nth<0>>, std::vector<error_t::select_nth<1>>>;
+    static_assert(std::is_same_v<decltype(r), partitioned<std::vector<int>, columns_t> const>);
+    REQUIRE(r.values == std::vector<int>{1, 2, 3});
+
+    // In the order of the copack's alternatives
+    constexpr std::size_t I = std::is_same_v<error_t::select_nth<0>, Error> ? 0 : 1;
+    auto const &codes = get<I>(r.errors);
+    auto const &timeouts = get<1 - I>(r.errors);
+    REQUIRE(codes == std::vector<Error>{Error::Negative, Error::Overflow});
+    REQUIRE(timeouts == std::vector<Timeout>{Timeout{5}});
+    REQUIRE(codes.capacity() == 2);
+    REQUIRE(timeouts.capacity() == 1);
+  }
+
+  SECTION("boxed alternatives stay boxed")
+  {
+    using boxed_error_t = copack_for<boxed<std::string>, Error>;
+    std::vector<expected<int, boxed_error_t>> const v{unexpected<boxed_error_t>{boxed{std::string{"bad"}}}, 1};
+    auto const r = partition_results(v, by_alternative);
+    constexpr std::size_t I = std::is_same_v<boxed_error_t::select_nth<0>, boxed<std::string>> ? 0 : 1;
+    REQUIRE(get<I>(r.errors).size() == 1);
+    REQUIRE(*get<I>(r.errors)[0] == "bad");
+    REQUIRE(get<1 - I>(r.errors).empty());
+  }
+
+  SECTION("no pre-pass where it would not be cheap")
+  {
+    // A list is walked once
+    std::list<operand_t> const list{input.begin(), input.end()};
+    auto const r = partition_results(list);
+    REQUIRE(r.values == std::vector<int>{1, 2, 3});
+    REQUIRE(r.errors.size() == 3);
+
+    // The elements of a transforming view are computed once each
+    int computed = 0;
+    auto const view = input | std::views::transform([&computed](operand_t const &e) {
+                        ++computed;
+                        return e;
+                      });
+    auto const s = partition_results(view, by_alternative);
+    REQUIRE(computed == 6);
+    REQUIRE(s.values == std::vector<int>{1, 2, 3});
+
+    // A random-access view of stored elements which is not sized is walked once, both ways
+    int tested = 0;
+    auto const prefix = input | std::views::take_while([&tested](operand_t const &) {
+                          ++tested;
+                          return true;
+                        });
+    static_assert(std::ranges::random_access_range<decltype(prefix)>);
+    static_assert(not std::ranges::sized_range<decltype(prefix)>);
+    auto const t = partition_results(prefix);
+    REQUIRE(tested == 6);
+    REQUIRE(t.values == std::vector<int>{1, 2, 3});
+    REQUIRE(t.errors.size() == 3);
+    auto const u = partition_results(prefix, by_alternative);
+    REQUIRE(tested == 12);
+    REQUIRE(u.values == std::vector<int>{1, 2, 3});
+  }
+
+  SECTION("values are moved from an owning rvalue, copied otherwise")
+  {
+    using counted_t = expected<Counted, Error>;
+    std::vector<counted_t> v;
+    v.emplace_back(std::in_place, 1);
+    v.emplace_back(unexpected(Error::Negative));
+
+    auto const copied = partition_results(v);
+    REQUIRE(copied.values[0].copies == 1);
+    auto const moved = partition_results(std::move(v));
+    REQUIRE(moved.values[0].copies == 0);
+    REQUIRE(moved.errors == std::vector<Error>{Error::Negative});
+  }
+
+  SECTION("constant evaluation")
+  {
+    constexpr auto fn = [] {
+      std::vector<expected<int, Error>> v{1, unexpected(Error::Negative), 2};
+      auto const r = partition_results(v);
+      return r.values.size() * 10 + r.errors.size();
+    };
+    static_assert(fn() == 21);
+  }
+
+  static_assert(not std::is_invocable_v<partition_results_t const &, std::vector<expected<void, Error>> &>);
+  static_assert(not std::is_invocable_v<partition_results_t const &, std::vector<expected<int, Error>> &,
+                                        by_alternative_t>);
+}
@@ -0,0 +1,128 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/and_then.hpp>
+#include <fn/pipeline_error.hpp>
+#include <fn/transform.hpp>
+#include <fn/transform_error.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace {
+enum class ParseError { Bad };
+enum class RangeError { TooBig };
+
+// Counts how often it is moved, carried along in its copy
+struct StoreError final {
+  int moves = 0;
+  StoreError() = default;
+  StoreError(StoreError const &) = default;
+  StoreError(StoreError &&o) noexcept : moves(o.moves + 1) {}
+  StoreError &operator=(StoreError const &) = default;
+  StoreError &operator=(StoreError &&) noexcept = default;
+  bool operator==(StoreError const &) const noexcept { return true; }
+};
+
+using parse_t = fn::expected<int, fn::copack<ParseError>>;
+using range_t = fn::expected<int, fn::copack<RangeError>>;
+using store_t = fn::expected<int, fn::copack<StoreError>>;
+
+constexpr auto parse = [](std::string const &s) -> parse_t {
+  if (s.empty())
+    return fn::unexpected<fn::copack<ParseError>>{ParseError::Bad};
+  return static_cast<int>(s.size());
+};
+constexpr auto check = [](int i) -> range_t {
+  if (i > 3)
+    return fn::unexpected<fn::copack<RangeError>>{RangeError::TooBig};
+  return i;
+};
+auto const store = [](int i) -> store_t {
+  if (i == 0)
+    return fn::unexpected<fn::copack<StoreError>>{StoreError{}};
+  return i * 10;
+};
+} // namespace
+
+TEST_CASE("pipeline_error", "[pipeline_error][functor][pipeline]")
+{
+  using namespace fn;
+  using operand_t = expected<std::string, copack<ParseError>>;
+  using final_t = copack_for<ParseError, RangeError, StoreError>;
+
+  auto const steps = pipeline(and_then(parse), and_then(check), and_then(store));
+  static_assert(std::is_same_v<pipeline_error_t<operand_t, decltype(steps) const &>, final_t>);
+  static_assert(
+      std::is_same_v<pipeline_error_t<parse_t, decltype(and_then(check))>, copack_for<ParseError, RangeError>>);
+
+  SECTION("the same results as the plain pipeline")
+  {
+    auto const presized = presized_pipeline(and_then(check), and_then(store));
+    using result_t = decltype(operand_t{"ab"} | and_then(parse) | presized);
+    static_assert(std::is_same_v<result_t, decltype(operand_t{"ab"} | and_then(parse) | and_then(check)
+                                                    | and_then(store))>);
+
+    REQUIRE((parse_t{2} | presized).value() == 20);
+    REQUIRE((parse_t{unexpected<copack<ParseError>>{ParseError::Bad}} | presized).error().has_value<ParseError>());
+    REQUIRE((parse_t{5} | presized).error().has_value<RangeError>());
+
+    // a pipeline step contributes its own steps
+    auto const nested = presized_pipeline(and_then(parse), presized);
+    REQUIRE((operand_t{"abc"} | nested).value() == 30);
+    REQUIRE((operand_t{""} | nested).error() == final_t{ParseError::Bad});
+  }
+
+  SECTION("an error is widened once, where it is made")
+  {
+    using wide_t = copack_for<ParseError, RangeError, StoreError, std::string>;
+    auto const more = [](int i) -> expected<int, copack<std::string>> { return i; };
+
+    // made at the first step, carried on by the last two
+    auto const plain = pipeline(and_then(store), and_then(check), and_then(more));
+    auto const presized = presized_pipeline(and_then(store), and_then(check), and_then(more));
+    parse_t const zero{0};
+    auto const a = zero | plain;
+    auto const b = zero | presized;
+    static_assert(std::is_same_v<decltype(a), decltype(b)>);
+    static_assert(std::is_same_v<decltype(b), expected<int, wide_t> const>);
+    REQUIRE(b.error().has_value<StoreError>());
+    REQUIRE(b.error().get_ptr<StoreError>()->moves == a.error().get_ptr<StoreError>()->moves);
+
+    // each step takes the widened operand to a result of its own type, never a wider copack
+    using operand_t = detail::_presized<parse_t const &, decltype(and_then(store)) const &,
+                                        decltype(and_then(check)) const &, decltype(and_then(more)) const &>::operand_t;
+    static_assert(std::is_same_v<operand_t, expected<int, wide_t>>);
+    static_assert(std::is_same_v<decltype(std::declval<operand_t>() | and_then(store)), operand_t>);
+    static_assert(std::is_same_v<decltype(std::declval<operand_t>() | and_then(check)), operand_t>);
+    static_assert(std::is_same_v<decltype(std::declval<operand_t>() | and_then(more)), operand_t>);
+  }
+
+  SECTION("the steps run as they are where the error narrows")
+  {
+    auto const describe = [](auto const &) { return std::string{"failed"}; };
+    auto const presized = presized_pipeline(and_then(check), transform_error(describe));
+    static_assert(not detail::_presized<parse_t &&, decltype(and_then(check)) const &,
+                                        decltype(transform_error(describe)) const &>::value);
+    REQUIRE((parse_t{5} | presized).error() == copack<std::string>{std::string{"failed"}});
+    REQUIRE((parse_t{2} | presized).value() == 2);
+
+    // or there is no copack error to widen
+    auto const next = presized_pipeline(transform([](int i) { return i + 1; }));
+    REQUIRE((expected<int, std::string>{3} | next).value() == 4);
+  }
+
+  SECTION("constant evaluation")
+  {
+    constexpr auto fn = [] {
+      auto const r = parse_t{5} | presized_pipeline(and_then(check), and_then(check));
+      return r.error().has_value<RangeError>();
+    };
+    static_assert(fn());
+  }
+}
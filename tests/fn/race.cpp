@@ -0,0 +1,280 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/race.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+enum class Error { Timeout, Refused };
+
+struct Inline final {
+  void execute(auto &&fn) { fn(); }
+};
+
+// A clock which moves only when told to: a task sleeping on it wakes when the test advances it past
+// the task's deadline, or - polling its token - soon after the task is cancelled.
+class VirtualClock final {
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  long now_ = 0;
+  int sleeping_ = 0;
+
+public:
+  void sleep_for(long duration, fn::cancel_token const &token)
+  {
+    std::unique_lock lock{mutex_};
+    auto const deadline = now_ + duration;
+    ++sleeping_;
+    cv_.notify_all();
+    while (not cv_.wait_for(lock, std::chrono::milliseconds(1),
+                            [&] { return now_ >= deadline || token.stop_requested(); })) {
+    }
+    --sleeping_;
+  }
+
+  void wait_sleeping(int count)
+  {
+    std::unique_lock lock{mutex_};
+    cv_.wait(lock, [&] { return sleeping_ == count; });
+  }
+
+  void advance_to(long time)
+  {
+    std::lock_guard const lock{mutex_};
+    now_ = time;
+    cv_.notify_all();
+  }
+};
+
+// One thread per task
+struct Threads final {
+  std::vector<std::thread> threads;
+
+  void execute(auto &&fn) { threads.emplace_back(std::move(fn)); }
+
+  ~Threads()
+  {
+    for (auto &t : threads)
+      t.join();
+  }
+};
+
+struct Replica final {
+  long latency;
+  bool ok;
+};
+
+using R = fn::expected<int, Error>;
+
+// Runs a race of replicas over the virtual clock, stepping it from one deadline to the next and
+// letting each woken replica finish before the next one wakes - on a thread of its own, or on the
+// caller's, which takes up any replica no thread has started. Returns the result, and the virtual
+// time at which its future became ready: the clock is held still while the future is awaited, for a
+// real-time grace period at most - or for good once every replica has finished.
+template <std::size_t N> auto simulate(std::array<Replica, N> const &replicas)
+{
+  using namespace std::chrono_literals;
+  VirtualClock clock;
+  Threads exec;
+  std::atomic<std::size_t> finished = 0;
+  auto const task = [&clock, &replicas, &finished](std::size_t i) {
+    return [&clock, &replicas, &finished, i](fn::cancel_token token) -> R {
+      clock.sleep_for(replicas[i].latency, token);
+      finished.fetch_add(1);
+      if (token.stop_requested())
+        return fn::unexpected<Error>{Error::Timeout};
+      if (not replicas[i].ok)
+        return fn::unexpected<Error>{Error::Refused};
+      return static_cast<int>(i);
+    };
+  };
+  auto result = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return std::async(std::launch::async, [&] { return fn::race(exec, task(Is)...); });
+  }(std::make_index_sequence<N>{});
+
+  clock.wait_sleeping(static_cast<int>(N));
+  std::vector<long> deadlines;
+  for (auto const &r : replicas)
+    deadlines.push_back(r.latency);
+  std::ranges::sort(deadlines);
+  long ready = -1;
+  for (std::size_t woken = 0; woken < N;) {
+    auto const now = deadlines[woken];
+    clock.advance_to(now);
+    while (woken < N && deadlines[woken] == now)
+      ++woken;
+    while (finished.load() < woken)
+      std::this_thread::yield();
+    if (woken == N)
+      result.wait();
+    if (result.wait_for(woken == N ? 0s : 100ms) == std::future_status::ready) {
+      ready = now;
+      break;
+    }
+  }
+  auto r = result.get();
+  // Release the cancelled replicas
+  clock.advance_to(deadlines.back());
+  return std::pair{std::move(r), ready};
+}
+
+// A synthetic latency distribution: mostly fast, with a slow tail
+struct Latencies final {
+  std::uint32_t state = 12345;
+  auto next() -> long
+  {
+    state = state * 1664525u + 1013904223u;
+    auto const u = (state >> 8) % 1000;
+    return u < 50 ? 500 + static_cast<long>(u) : 10 + static_cast<long>(u % 10);
+  }
+};
+
+auto p99(std::vector<long> v) -> long
+{
+  std::ranges::sort(v);
+  return v[v.size() * 99 / 100];
+}
+} // namespace
+
+TEST_CASE("race", "[race][disjoin][expected][optional]")
+{
+  using namespace fn;
+  using A = expected<int, Error>;
+  using B = expected<std::string, std::string>;
+
+  SECTION("result type is that of disjoin")
+  {
+    Inline exec;
+    auto const r = race(exec, [] { return A{1}; }, [] { return B{"b"}; });
+    using T = decltype(disjoin(A{1}, B{"b"}));
+    static_assert(std::is_same_v<decltype(r), T const>);
+    static_assert(std::is_same_v<T, expected<copack<int, std::string>, pack<Error, std::string>>>);
+    REQUIRE(r.value() == copack<int, std::string>{1});
+  }
+
+  SECTION("tasks not started after a success are skipped")
+  {
+    Inline exec;
+    bool second = false;
+    auto const r = race(
+        exec, [] { return A{1}; },
+        [&] {
+          second = true;
+          return A{2};
+        });
+    REQUIRE(r.value() == 1);
+    REQUIRE(not second);
+  }
+
+  SECTION("all failed returns the errors as disjoin does")
+  {
+    thread_pool pool{2};
+    auto const r = race(
+        pool, [] { return A{unexpect, Error::Timeout}; }, [] { return B{unexpect, "refused"}; },
+        [] { return A{unexpect, Error::Refused}; });
+    REQUIRE(r.error() == pack{Error::Timeout, std::string{"refused"}, Error::Refused});
+  }
+
+  SECTION("called from a worker of its own executor")
+  {
+    // The only worker is the caller: the tasks it queued on itself are taken up by the call
+    thread_pool pool{1};
+    auto const refused = [] { return A{unexpect, Error::Refused}; };
+    std::promise<decltype(disjoin(A{1}, A{2}))> result;
+    pool.execute([&] { result.set_value(race(pool, refused, [] { return A{2}; })); });
+    REQUIRE(result.get_future().get().value() == 2);
+  }
+
+  SECTION("optional")
+  {
+    thread_pool pool{2};
+    REQUIRE(race(pool, [] { return optional<int>{}; }, [] { return optional<int>{2}; }).value() == 2);
+    REQUIRE(not race(pool, [] { return optional<int>{}; }, [] { return optional<int>{}; }).has_value());
+  }
+
+  SECTION("void")
+  {
+    thread_pool pool{2};
+    using V = expected<void, Error>;
+    REQUIRE(race(pool, [] { return V{unexpect, Error::Refused}; }, [] { return V{}; }).has_value());
+  }
+
+  SECTION("exception")
+  {
+    thread_pool pool{2};
+    REQUIRE(race(pool, []() -> A { throw std::logic_error("task"); }, [] { return A{2}; }).value() == 2);
+    auto const refused = [] { return A{unexpect, Error::Refused}; };
+    REQUIRE_THROWS_AS(race(pool, []() -> A { throw std::logic_error("task"); }, refused), std::logic_error);
+  }
+
+  SECTION("virtual clock")
+  {
+    SECTION("first success in time wins, not the leftmost")
+    {
+      auto const [r, at] = simulate(std::array{Replica{30, true}, Replica{10, true}, Replica{20, true}});
+      REQUIRE(r.value() == 1);
+      REQUIRE(at == 10);
+    }
+
+    SECTION("a fast failure does not decide")
+    {
+      auto const [r, at] = simulate(std::array{Replica{30, true}, Replica{10, false}, Replica{20, true}});
+      REQUIRE(r.value() == 2);
+      REQUIRE(at == 20);
+    }
+
+    SECTION("all fail")
+    {
+      auto const [r, at] = simulate(std::array{Replica{30, false}, Replica{10, false}});
+      REQUIRE(r.error() == pack{Error::Refused, Error::Refused});
+      REQUIRE(at == 30);
+    }
+
+    SECTION("hedging cuts the tail")
+    {
+      // Three replicas with independent latencies against one: the 99th percentile of the race is
+      // that of the fastest of three, all but immune to the slow tail a single request hits
+      Latencies latencies;
+      std::vector<long> single;
+      std::vector<long> hedged;
+      for (int i = 0; i < 200; ++i) {
+        auto const a = latencies.next();
+        auto const b = latencies.next();
+        auto const c = latencies.next();
+        single.push_back(simulate(std::array{Replica{a, true}}).second);
+        hedged.push_back(simulate(std::array{Replica{a, true}, Replica{b, true}, Replica{c, true}}).second);
+      }
+      REQUIRE(p99(single) >= 500);
+      REQUIRE(p99(hedged) < 20);
+    }
+  }
+
+  SECTION("constraints")
+  {
+    constexpr auto bare = [] { return 1; };
+    constexpr auto carrier = [] { return A{1}; };
+    constexpr auto mixed = [] { return optional<int>{1}; };
+    static_assert(raceable<decltype(carrier) const &>);
+    static_assert(raceable<decltype(carrier), decltype(carrier) &>);
+    static_assert(not raceable<>);
+    static_assert(not raceable<decltype(bare)>);
+    static_assert(not raceable<decltype(carrier), decltype(mixed)>);
+  }
+}
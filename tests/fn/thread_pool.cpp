@@ -0,0 +1,121 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/thread_pool.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+struct Inline final {
+  void execute(auto &&fn) { fn(); }
+};
+} // namespace
+
+TEST_CASE("thread_pool", "[thread_pool]")
+{
+  using namespace fn;
+
+  static_assert(executor<thread_pool>);
+  static_assert(executor<Inline>);
+  static_assert(not executor<int>);
+
+  SECTION("at least one worker")
+  {
+    thread_pool pool{0};
+    REQUIRE(pool.size() == 1);
+  }
+
+  SECTION("destructor runs every task submitted")
+  {
+    std::atomic<int> count = 0;
+    {
+      thread_pool pool{4};
+      REQUIRE(pool.size() == 4);
+      for (int i = 0; i < 1000; ++i)
+        pool.execute([&count] { count.fetch_add(1); });
+    }
+    REQUIRE(count.load() == 1000);
+  }
+
+  SECTION("concurrent submission, with workers going to sleep in between")
+  {
+    std::atomic<int> count = 0;
+    {
+      thread_pool pool{3};
+      std::vector<std::thread> submitters;
+      for (int t = 0; t < 4; ++t)
+        submitters.emplace_back([&pool, &count] {
+          for (int i = 0; i < 1000; ++i) {
+            pool.execute([&count] { count.fetch_add(1); });
+            if (i % 100 == 0)
+              std::this_thread::sleep_for(std::chrono::microseconds(200));
+          }
+        });
+      for (auto &t : submitters)
+        t.join();
+    }
+    REQUIRE(count.load() == 4000);
+  }
+
+  SECTION("tasks submitted by tasks")
+  {
+    std::atomic<int> count = 0;
+    std::function<void(int)> spawn;
+    {
+      thread_pool pool{2};
+      spawn = [&](int depth) {
+        count.fetch_add(1);
+        if (depth > 0) {
+          pool.execute([&spawn, depth] { spawn(depth - 1); });
+          pool.execute([&spawn, depth] { spawn(depth - 1); });
+        }
+      };
+      pool.execute([&spawn] { spawn(8); });
+    }
+    REQUIRE(count.load() == 511);
+  }
+
+  SECTION("move-only task")
+  {
+    std::atomic<int> value = 0;
+    {
+      thread_pool pool{1};
+      pool.execute([p = std::make_unique<int>(42), &value] { value = *p; });
+    }
+    REQUIRE(value.load() == 42);
+  }
+
+  SECTION("work is spread and stolen")
+  {
+    std::mutex mutex;
+    std::set<std::thread::id> seen;
+    {
+      thread_pool pool{4};
+      for (int i = 0; i < 64; ++i)
+        pool.execute([&] {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          std::lock_guard const lock{mutex};
+          seen.insert(std::this_thread::get_id());
+        });
+    }
+    REQUIRE(seen.size() > 1);
+    REQUIRE(not seen.contains(std::this_thread::get_id()));
+  }
+
+  SECTION("shared")
+  {
+    REQUIRE(&thread_pool::shared() == &thread_pool::shared());
+    REQUIRE(thread_pool::shared().size() >= 1);
+  }
+}
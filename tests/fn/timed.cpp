@@ -0,0 +1,170 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/and_then.hpp>
+#include <fn/functor.hpp>
+#include <fn/inspect.hpp>
+#include <fn/timed.hpp>
+#include <fn/transform.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+namespace {
+enum class Error { Missing };
+
+auto count_of(std::string_view label) -> std::uint64_t
+{
+  auto const all = fn::timed_histograms();
+  auto const it = all.find(label);
+  return it == all.end() ? 0 : it->second.count();
+}
+} // namespace
+
+TEST_CASE("latency_histogram", "[timed]")
+{
+  using namespace fn;
+  using h = latency_histogram;
+
+  SECTION("buckets")
+  {
+    // Exact below 32, then 16 buckets per power of two
+    static_assert(h::bucket(0) == 0 && h::bucket(31) == 31);
+    static_assert(h::bucket(32) == 32 && h::bucket(33) == 32 && h::bucket(34) == 33);
+    static_assert(h::bucket(63) == 47 && h::bucket(64) == 48);
+    static_assert(h::highest(31) == 31 && h::highest(32) == 33 && h::highest(47) == 63);
+    static_assert(h::highest(h::buckets - 1) == ~std::uint64_t{0});
+    // Every bucket's largest duration falls in that bucket, and the next one starts just above it
+    constexpr auto consistent = [] {
+      for (std::size_t i = 0; i + 1 < h::buckets; ++i)
+        if (h::bucket(h::highest(i)) != i || h::bucket(h::highest(i) + 1) != i + 1)
+          return false;
+      return true;
+    };
+    static_assert(consistent());
+    // The relative error is at most 1/16
+    for (std::uint64_t ns : {100u, 1000u, 12345u, 1000000u, 987654321u})
+      REQUIRE(h::highest(h::bucket(ns)) - ns <= ns / 16);
+  }
+
+  SECTION("percentiles")
+  {
+    h histogram;
+    REQUIRE(histogram.percentile(0.5) == 0);
+    for (std::uint64_t i = 1; i <= 100; ++i)
+      histogram.record(i);
+    REQUIRE(histogram.count() == 100);
+    REQUIRE(histogram.percentile(0.1) == 10);
+    auto const p99 = histogram.percentile(0.99);
+    REQUIRE(p99 >= 99);
+    REQUIRE(p99 <= 99 + 99 / 16);
+    REQUIRE(histogram.percentile(1.0) >= 100);
+  }
+
+  SECTION("merge")
+  {
+    h a;
+    h b;
+    a.record(5);
+    b.record(5);
+    b.record(1000, 3);
+    a += b;
+    REQUIRE(a.count() == 5);
+    REQUIRE(a.count(h::bucket(5)) == 2);
+    REQUIRE(a.count(h::bucket(1000)) == 3);
+  }
+}
+
+TEST_CASE("timed", "[timed][functor]")
+{
+  using namespace fn;
+  using operand_t = expected<int, Error>;
+
+  SECTION("same result as the step")
+  {
+    auto const step = and_then([](int i) { return operand_t{i + 1}; });
+    auto const wrapped = timed("same result", step);
+    static_assert(std::is_same_v<decltype(operand_t{1} | wrapped), decltype(operand_t{1} | step)>);
+    static_assert(noexcept(operand_t{1} | wrapped) == noexcept(operand_t{1} | step));
+    REQUIRE((operand_t{1} | wrapped).value() == 2);
+
+    // A step returning its operand by reference still does
+    operand_t const v{3};
+    auto const peek = timed("same result", inspect([](int) {}));
+    static_assert(std::is_same_v<decltype(v | peek), operand_t const &>);
+    REQUIRE(&(v | peek) == &v);
+    REQUIRE(count_of("same result") >= 2);
+  }
+
+  SECTION("one histogram per label")
+  {
+    auto const before_slow = count_of("slow");
+    auto const before_fast = count_of("fast");
+    auto const r = operand_t{1} //
+                   | timed("slow", transform([](int i) {
+                             std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                             return i;
+                           }))
+                   | timed("fast", transform([](int i) { return i; }));
+    REQUIRE(r.value() == 1);
+    auto const all = timed_histograms();
+    REQUIRE(all.at("slow").count() == before_slow + 1);
+    REQUIRE(all.at("fast").count() == before_fast + 1);
+    REQUIRE(all.at("slow").percentile(1.0) >= 2'000'000);
+  }
+
+  SECTION("merged across threads")
+  {
+    auto const before = count_of("threads");
+    auto const run = [] {
+      for (int i = 0; i < 100; ++i)
+        (void)(operand_t{i} | timed("threads", transform([](int j) { return j; })));
+    };
+    std::thread a{run};
+    std::thread b{run};
+    run();
+    a.join();
+    b.join();
+    REQUIRE(count_of("threads") == before + 300);
+  }
+
+  SECTION("threads which end are merged per label")
+  {
+    auto const before = count_of("per request");
+    auto const registered = [] {
+      auto &registry = detail::_timed_registry::instance();
+      std::lock_guard const lock{registry.mutex};
+      return registry.stages.size();
+    };
+    auto const stages = registered();
+    for (int i = 0; i < 20; ++i)
+      std::thread{[] {
+        (void)(operand_t{1} | timed("per request", transform([](int j) { return j; })));
+      }}.join();
+    REQUIRE(registered() == stages);
+    REQUIRE(count_of("per request") == before + 20);
+  }
+
+  SECTION("exception")
+  {
+    auto const before = count_of("throws");
+    auto const step = timed("throws", transform([](int) -> int { throw std::runtime_error("step"); }));
+    REQUIRE_THROWS_AS(operand_t{1} | step, std::runtime_error);
+    REQUIRE(count_of("throws") == before + 1);
+  }
+
+  SECTION("constant evaluation")
+  {
+    constexpr auto r = operand_t{1} | timed("constant", transform([](int i) { return i + 1; }));
+    static_assert(r.value() == 2);
+    REQUIRE(count_of("constant") == 0);
+  }
+}
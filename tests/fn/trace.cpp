@@ -0,0 +1,130 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+// The LIBFN_TRACE mode is chosen for a whole program, as LIBFN_COLD_ERRORS is
+#define LIBFN_TRACE
+
+#include <fn/and_then.hpp>
+#include <fn/functor.hpp>
+#include <fn/or_else.hpp>
+#include <fn/trace.hpp>
+#include <fn/transform.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace {
+enum class Error { Missing };
+struct Timeout final {};
+struct Refused final {};
+
+auto drain() -> std::vector<fn::trace_event>
+{
+  std::vector<fn::trace_event> events;
+  fn::drain_trace([&](fn::trace_event const &e) { events.push_back(e); });
+  return events;
+}
+
+int sunk = 0;
+void counting_sink(fn::trace_event const &) noexcept { ++sunk; }
+} // namespace
+
+TEST_CASE("trace", "[trace][functor]")
+{
+  using namespace fn;
+  using detail::type_sortkey_v;
+  drain();
+
+  SECTION("value path")
+  {
+    auto const r = expected<int, Error>{1} | and_then([](int i) { return expected<int, Error>{i + 1}; })
+                   | transform([](int i) { return i * 2; });
+    REQUIRE(r.value() == 4);
+    auto const events = drain();
+    REQUIRE(events.size() == 2);
+    REQUIRE(events[0].verb == type_sortkey_v<and_then_t>);
+    REQUIRE(events[0].carrier == trace_carrier::expected);
+    REQUIRE(events[0].path == trace_path::value);
+    REQUIRE(events[0].alternative == trace_event::npos);
+    REQUIRE(events[1].verb == type_sortkey_v<transform_t>);
+  }
+
+  SECTION("error path")
+  {
+    using E = copack_for<Timeout, Refused>;
+    (void)(expected<int, E>{unexpect, Refused{}} | or_else([](auto) { return expected<int, E>{0}; }));
+    auto const events = drain();
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].verb == type_sortkey_v<or_else_t>);
+    REQUIRE(events[0].path == trace_path::error);
+    REQUIRE(events[0].alternative == E{Refused{}}.index);
+    REQUIRE(events[0].alternative_name == type_sortkey_v<Refused>);
+
+    (void)(expected<int, Error>{unexpect, Error::Missing} | transform([](int i) { return i; }));
+    auto const single = drain();
+    REQUIRE(single.size() == 1);
+    REQUIRE(single[0].path == trace_path::error);
+    REQUIRE(single[0].alternative == trace_event::npos);
+    REQUIRE(single[0].alternative_name.empty());
+  }
+
+  SECTION("optional")
+  {
+    (void)(optional<int>{} | transform([](int i) { return i; }));
+    auto const events = drain();
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].carrier == trace_carrier::optional);
+    REQUIRE(events[0].path == trace_path::error);
+  }
+
+  SECTION("pipeline")
+  {
+    auto const p = pipeline(transform([](int i) { return i + 1; }), transform([](int i) { return i * 2; }));
+    REQUIRE((expected<int, Error>{1} | p).value() == 4);
+    auto const events = drain();
+    // The pipeline itself, then each step it runs - here one, the two transforms fused
+    REQUIRE(events.size() == 2);
+    REQUIRE(events[0].verb == type_sortkey_v<pipeline_t>);
+    REQUIRE(events[1].verb == type_sortkey_v<transform_t>);
+  }
+
+  SECTION("constant evaluation is not traced")
+  {
+    constexpr auto r = expected<int, Error>{1} | transform([](int i) { return i + 1; });
+    static_assert(r.value() == 2);
+    REQUIRE(drain().empty());
+  }
+
+  SECTION("other threads")
+  {
+    std::thread([] { (void)(optional<int>{1} | transform([](int i) { return i; })); }).join();
+    auto const events = drain();
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].path == trace_path::value);
+    REQUIRE(drain().empty());
+  }
+
+  SECTION("full ring drops")
+  {
+    auto const before = trace_dropped();
+    for (std::size_t i = 0; i < detail::_trace_ring::capacity + 3; ++i)
+      (void)(optional<int>{1} | transform([](int i) { return i; }));
+    REQUIRE(trace_dropped() == before + 3);
+    REQUIRE(drain().size() == detail::_trace_ring::capacity);
+  }
+
+  SECTION("custom sink")
+  {
+    sunk = 0;
+    auto const previous = set_trace_sink(&counting_sink);
+    (void)(optional<int>{1} | transform([](int i) { return i; }));
+    REQUIRE(set_trace_sink(nullptr) == &counting_sink);
+    REQUIRE(previous == set_trace_sink(nullptr));
+    REQUIRE(sunk == 1);
+    REQUIRE(drain().empty());
+  }
+}
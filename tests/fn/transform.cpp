@@ -777,6 +777,78 @@ TEST_CASE("transform tuple-like payload", "[transform][expected][optional][tuple
   }
 }
 
+TEST_CASE("transform fusion", "[transform][expected][optional][pipeline]")
+{
+  // Counts the moves of a value, to observe that no intermediate carrier was built around it
+  struct Counted final {
+    int value;
+    int *moves;
+    constexpr Counted(int v, int *m) noexcept : value(v), moves(m) {}
+    constexpr Counted(Counted &&o) noexcept : value(o.value), moves(o.moves) { ++*moves; }
+  };
+
+  int moves = 0;
+  int calls = 0;
+  auto const f = [&moves, &calls](int i) noexcept -> Counted {
+    ++calls;
+    return {i + 1, &moves};
+  };
+  constexpr auto g = [](Counted const &c) noexcept -> int { return c.value * 2; };
+  constexpr auto h = [](int i) noexcept -> int { return i - 3; };
+
+  // adjacent transforms of a composition are fused: g(f(v)) in one call, no carrier in between
+  using E = fn::expected<int, Error>;
+  using S1 = decltype(fn::transform(f));
+  using S2 = decltype(fn::transform(g));
+  static_assert(fn::detail::_fusible<E &&, S1 &&, S2 &&>);
+
+  CHECK((E{3} | (fn::transform(f) | fn::transform(g) | fn::transform(h))).value() == 5);
+  CHECK(calls == 1);
+  CHECK(moves == 0);
+
+  // the same result, in the same type, as the steps piped one at a time
+  CHECK((E{3} | fn::transform(f) | fn::transform(g) | fn::transform(h)).value() == 5);
+  static_assert(std::is_same_v<decltype(E{3} | (fn::transform(f) | fn::transform(g))),
+                               decltype(E{3} | fn::transform(f) | fn::transform(g))>);
+
+  // the error is carried once, at the end
+  CHECK((E{fn::unexpect, "bad"} | (fn::transform(f) | fn::transform(g))).error().what == "bad");
+  CHECK(calls == 2);
+  CHECK(moves == 0);
+
+  moves = 0;
+  fn::optional<int> o{3};
+  CHECK((o | (fn::transform(f) | fn::transform(g))).value() == 8);
+  CHECK(moves == 0);
+
+  // a copack intermediate is not fused: its steps mean a dispatch, which the chain keeps
+  constexpr auto split = [](int i) noexcept -> fn::copack_for<int, Xint> {
+    if (i > 0)
+      return {i};
+    return {Xint{i}};
+  };
+  constexpr auto join = fn::overload{[](int i) noexcept { return i; }, [](Xint x) noexcept { return x.value - 1; }};
+  static_assert(not fn::detail::_fusible<E &&, decltype(fn::transform(split)) &&, decltype(fn::transform(join)) &&>);
+  CHECK((E{3} | (fn::transform(split) | fn::transform(join))).value() == fn::copack<int>{3});
+  CHECK((E{-3} | (fn::transform(split) | fn::transform(join))).value() == fn::copack<int>{-4});
+
+  SECTION("constexpr")
+  {
+    constexpr auto inc = [](int i) noexcept { return i + 1; };
+    static_assert((fn::optional<int>{2} | (fn::transform(inc) | fn::transform(h) | fn::transform(inc))).value() == 1);
+    static_assert((E{2} | (fn::transform(inc) | fn::transform(h))).value() == 0);
+    SUCCEED();
+  }
+
+  SECTION("noexcept")
+  {
+    static_assert(noexcept(std::declval<E>() | (fn::transform(f) | fn::transform(g))));
+    constexpr auto throwing = [](Counted const &) { return 0; };
+    static_assert(not noexcept(std::declval<E>() | (fn::transform(f) | fn::transform(throwing))));
+    SUCCEED();
+  }
+}
+
 TEST_CASE("transform over an uninhabited value side", "[transform][expected][optional][copack]")
 {
   // A copack<> value can never be constructed, so the callback can never be presented one: the
@@ -0,0 +1,174 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/boxed.hpp>
+#include <fn/transform_error.hpp>
+#include <fn/transform_error_only.hpp>
+#include <fn/utility.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace {
+enum class Error { Bad };
+
+struct Timeout final {
+  int ms;
+  constexpr bool operator==(Timeout const &) const noexcept = default;
+};
+
+struct Enriched final {
+  int ms;
+  std::string where;
+  bool operator==(Enriched const &) const = default;
+};
+
+// Counts how often it is made by copying or moving
+struct Payload final {
+  int copies = 0;
+  int moves = 0;
+  Payload() = default;
+  Payload(Payload const &o) : copies(o.copies + 1), moves(o.moves) {}
+  Payload(Payload &&o) noexcept : copies(o.copies), moves(o.moves + 1) {}
+  Payload &operator=(Payload const &) = default;
+  Payload &operator=(Payload &&) noexcept = default;
+  bool operator==(Payload const &) const noexcept { return true; }
+};
+
+// Instantiating this callable for any argument other than Timeout is a hard error
+struct OnlyTimeout final {
+  constexpr auto operator()(Timeout t) const noexcept -> Timeout { return {t.ms + 1}; }
+  template <typename T> constexpr auto operator()(T &&) const -> Timeout
+  {
+    static_assert(sizeof(T) == 0);
+    return {};
+  }
+};
+} // namespace
+
+TEST_CASE("transform_error_only", "[transform_error_only][expected][copack]")
+{
+  using namespace fn;
+  using error_t = copack_for<Error, Timeout, std::string>;
+  using operand_t = expected<int, error_t>;
+
+  auto const enrich = [](Timeout t) { return Enriched{t.ms, "fetch"}; };
+  using enriched_t = expected<int, copack_for<Error, Enriched, std::string>>;
+
+  static_assert(applicable_transform_error_only<Timeout, decltype(enrich) const &, operand_t>);
+  static_assert(not applicable_transform_error_only<int, decltype(enrich) const &, operand_t>);
+  static_assert(not applicable_transform_error_only<Error, decltype(enrich) const &, operand_t>);
+  static_assert(not applicable_transform_error_only<Timeout, decltype(enrich) const &, expected<int, Timeout>>);
+  static_assert(not applicable_transform_error_only<Timeout, decltype(enrich) const &, optional<int>>);
+
+  SECTION("the alternative is mapped")
+  {
+    operand_t const a = unexpected<error_t>{Timeout{5}};
+    auto const r = a | transform_error_only<Timeout>(enrich);
+    static_assert(std::is_same_v<decltype(r), enriched_t const>);
+    REQUIRE(r.error() == copack_for<Error, Enriched, std::string>{Enriched{5, "fetch"}});
+  }
+
+  SECTION("the other alternatives are carried over")
+  {
+    operand_t const a = unexpected<error_t>{std::string{"other"}};
+    REQUIRE((a | transform_error_only<Timeout>(enrich)).error()
+            == copack_for<Error, Enriched, std::string>{std::string{"other"}});
+    operand_t const b = unexpected<error_t>{Error::Bad};
+    REQUIRE((b | transform_error_only<Timeout>(enrich)).error()
+            == copack_for<Error, Enriched, std::string>{Error::Bad});
+  }
+
+  SECTION("the value is carried over")
+  {
+    REQUIRE((operand_t{3} | transform_error_only<Timeout>(enrich)).value() == 3);
+    expected<void, error_t> const v{};
+    REQUIRE((v | transform_error_only<Timeout>(enrich)).has_value());
+  }
+
+  SECTION("the callback sees only its alternative")
+  {
+    operand_t const a = unexpected<error_t>{Timeout{1}};
+    auto const r = a | transform_error_only<Timeout>(OnlyTimeout{});
+    static_assert(std::is_same_v<decltype(r), operand_t const>);
+    REQUIRE(r.error() == error_t{Timeout{2}});
+    static_assert(noexcept(a | transform_error_only<Timeout>(OnlyTimeout{})) == noexcept(operand_t{a}));
+  }
+
+  SECTION("mapping into another alternative or a copack")
+  {
+    operand_t const a = unexpected<error_t>{Timeout{1}};
+    auto const r = a | transform_error_only<Timeout>([](Timeout) { return Error::Bad; });
+    static_assert(std::is_same_v<decltype(r), expected<int, copack_for<Error, std::string>> const>);
+    REQUIRE(r.error() == copack_for<Error, std::string>{Error::Bad});
+
+    using wide_t = copack_for<Enriched, int>;
+    auto const s = a | transform_error_only<Timeout>([](Timeout t) -> wide_t { return t.ms; });
+    static_assert(std::is_same_v<decltype(s), expected<int, copack_for<Error, Enriched, int, std::string>> const>);
+    REQUIRE(s.error() == copack_for<Error, Enriched, int, std::string>{1});
+  }
+
+  SECTION("boxed alternative")
+  {
+    using boxed_error_t = copack_for<boxed<Enriched>, Error>;
+    expected<int, boxed_error_t> const a = unexpected<boxed_error_t>{boxed{Enriched{1, "a"}}};
+    auto const r = a | transform_error_only<boxed<Enriched>>([](Enriched const &e) { return e.where; });
+    static_assert(std::is_same_v<decltype(r), expected<int, copack_for<Error, std::string>> const>);
+    REQUIRE(r.error() == copack_for<Error, std::string>{std::string{"a"}});
+  }
+}
+
+TEST_CASE("transform_error_only carries the other alternatives once", "[transform_error_only][expected][copack]")
+{
+  using namespace fn;
+  using error_t = copack_for<Payload, Timeout>;
+  using operand_t = expected<int, error_t>;
+  using mapped_t = expected<int, copack_for<Payload, Enriched>>;
+
+  auto const enrich = [](Timeout t) { return Enriched{t.ms, "fetch"}; };
+  auto const by_value = [](error_t const &e) -> int {
+    return e.get_ptr<Payload>()->copies * 10 + e.get_ptr<Payload>()->moves;
+  };
+
+  SECTION("into a new copack, one move")
+  {
+    operand_t a = unexpected<error_t>{Payload{}};
+    int const before = by_value(a.error());
+    mapped_t const r = std::move(a) | transform_error_only<Timeout>(enrich);
+    REQUIRE(r.error().get_ptr<Payload>()->moves == before % 10 + 1);
+    REQUIRE(r.error().get_ptr<Payload>()->copies == before / 10);
+
+    // where an identity arm of transform_error makes it twice
+    operand_t b = unexpected<error_t>{Payload{}};
+    mapped_t const s = std::move(b) | transform_error(overload(enrich, [](Payload &&p) { return std::move(p); }));
+    REQUIRE(s.error().get_ptr<Payload>()->moves > r.error().get_ptr<Payload>()->moves);
+  }
+
+  SECTION("into the same copack, passed on whole")
+  {
+    operand_t a = unexpected<error_t>{Payload{}};
+    int const before = by_value(a.error());
+    operand_t const r = std::move(a) | transform_error_only<Timeout>([](Timeout t) { return Timeout{t.ms * 2}; });
+    REQUIRE(by_value(r.error()) == before + 1);
+
+    operand_t const c = unexpected<error_t>{Payload{}};
+    operand_t const s = c | transform_error_only<Timeout>([](Timeout t) { return Timeout{t.ms * 2}; });
+    REQUIRE(by_value(s.error()) == by_value(c.error()) + 10);
+  }
+
+  SECTION("constant evaluation")
+  {
+    using small_t = expected<int, copack_for<Error, Timeout>>;
+    constexpr auto fn = [] {
+      small_t const a = unexpected<copack_for<Error, Timeout>>{Timeout{20}};
+      auto const r = a | transform_error_only<Timeout>([](Timeout t) { return t.ms + 1; });
+      return *r.error().get_ptr<int>();
+    };
+    static_assert(fn() == 21);
+  }
+}
@@ -0,0 +1,182 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include "util/static_check.hpp"
+
+#include <fn/value_or_else.hpp>
+
+#include <util/helper_types.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <type_traits>
+#include <utility>
+
+using namespace util;
+
+namespace {
+enum class Error { Bad };
+} // namespace
+
+TEST_CASE("value_or_else", "[value_or_else][expected][expected_value]")
+{
+  using namespace fn;
+  using operand_t = expected<std::string, Error>;
+
+  int calls = 0;
+  auto const fallback = [&calls] {
+    ++calls;
+    return std::string{"fallback"};
+  };
+
+  SECTION("value: the thunk is not invoked")
+  {
+    operand_t a{"own"};
+    static_assert(std::is_same_v<decltype(a | value_or_else(fallback)), operand_t>);
+    REQUIRE((a | value_or_else(fallback)).value() == "own");
+    REQUIRE((operand_t{"own"} | value_or_else(fallback)).value() == "own");
+    REQUIRE(calls == 0);
+  }
+
+  SECTION("error: the thunk builds the value")
+  {
+    operand_t a{unexpect, Error::Bad};
+    REQUIRE((a | value_or_else(fallback)).value() == "fallback");
+    REQUIRE((std::move(a) | value_or_else(fallback)).value() == "fallback");
+    REQUIRE(calls == 2);
+
+    // the thunk's return converts to the value
+    REQUIRE((a | value_or_else([] { return "converted"; })).value() == "converted");
+  }
+
+  SECTION("in place, with no temporary")
+  {
+    // the value is initialized from the thunk's own return: never moved, where value_or moves its
+    // argument into the carrier
+    using move_only_t = expected<helper_move_only, Error>;
+    auto const make = [] { return helper_move_only{3, 7}; };
+    REQUIRE((move_only_t{unexpect, Error::Bad} | value_or_else(make)).value().v == 21);
+
+    // a value held is carried over as value_or carries it
+    REQUIRE((move_only_t{std::in_place, 2} | value_or_else(make)).value().v == 2 * from_rval);
+  }
+
+  SECTION("constexpr")
+  {
+    using T = expected<int, Error>;
+    constexpr auto r1 = T{2} | value_or_else([] { return 3; });
+    static_assert(r1.value() == 2);
+    constexpr auto r2 = T{unexpect, Error::Bad} | value_or_else([] { return 3; });
+    static_assert(r2.value() == 3);
+    SUCCEED();
+  }
+}
+
+TEST_CASE("value_or_else", "[value_or_else][optional]")
+{
+  using namespace fn;
+  using operand_t = optional<int>;
+
+  int calls = 0;
+  auto const fallback = [&calls] { return ++calls; };
+
+  operand_t a{12};
+  static_assert(std::is_same_v<decltype(a | value_or_else(fallback)), operand_t>);
+  REQUIRE((a | value_or_else(fallback)).value() == 12);
+  REQUIRE(calls == 0);
+  REQUIRE((operand_t{} | value_or_else(fallback)).value() == 1);
+  REQUIRE(calls == 1);
+
+  SECTION("reference")
+  {
+    // the thunk binds the result to its referent: a prvalue has none
+    int i = 5;
+    auto const referent = [&i]() -> int & { return i; };
+    REQUIRE(&(optional<int &>{} | value_or_else(referent)).value() == &i);
+    static_assert(applicable_value_or_else<decltype(referent), optional<int &> &>);
+    static_assert(not applicable_value_or_else<decltype(fallback), optional<int &> &>);
+  }
+
+  SECTION("constexpr")
+  {
+    constexpr auto r = operand_t{} | value_or_else([] { return 3; });
+    static_assert(r.value() == 3);
+    SUCCEED();
+  }
+}
+
+TEST_CASE("value_or_else void expected", "[value_or_else][expected][expected_void]")
+{
+  // The thunk returns nothing: it is run for its effect, and the failed operand comes back engaged
+  using operand_t = fn::expected<void, int>;
+  int calls = 0;
+  auto const effect = [&calls] { ++calls; };
+
+  REQUIRE((operand_t{} | fn::value_or_else(effect)).has_value());
+  REQUIRE(calls == 0);
+  REQUIRE((operand_t{fn::unexpect, 7} | fn::value_or_else(effect)).has_value());
+  REQUIRE(calls == 1);
+
+  static_assert(monadic_static_check<fn::value_or_else_t, operand_t>::invocable_with_any(effect));
+  static_assert(monadic_static_check<fn::value_or_else_t, operand_t>::not_invocable_with_any([] { return 1; }));
+}
+
+TEST_CASE("value_or_else identity", "[value_or_else][expected][copack][just][choice]")
+{
+  using namespace fn;
+
+  // the thunk stays constrained yet dead: the held value comes back as it is
+  using operand_t = expected<int, copack<>>;
+  static_assert(monadic_static_check<value_or_else_t, operand_t>::invocable_with_any([] { return 9; }));
+  static_assert(monadic_static_check<value_or_else_t, operand_t>::not_invocable_with_any([] { return "nine"; }));
+  REQUIRE((operand_t{5} | value_or_else([] { return 9; })).value() == 5);
+  static_assert((operand_t{5} | value_or_else([] { return 9; })).value() == 5);
+
+  // choice and just can never lack a value
+  auto const nine = [] { return 9; };
+  static_assert(std::is_same_v<decltype(just<int>{5} | value_or_else(nine)), just<int>>);
+  REQUIRE((just<int>{5} | value_or_else(nine)).value() == 5);
+  static_assert(std::is_same_v<decltype(choice<int>{5} | value_or_else(nine)), choice<int>>);
+  REQUIRE((choice<int>{5} | value_or_else(nine)) == choice<int>{5});
+  static_assert(noexcept(just<int>{5} | value_or_else(nine)));
+  static_assert(monadic_static_check<value_or_else_t, just<int>>::not_invocable_with_any(9));
+}
+
+TEST_CASE("value_or_else noexcept", "[value_or_else][noexcept]")
+{
+  using namespace fn;
+
+  // the thunk and the construction of the value from its return weigh; the discarded error does not
+  auto const nothrow = []() noexcept { return 1; };
+  auto const throwing = [] { return 1; };
+  static_assert(noexcept(std::declval<expected<int, std::string> &>() | value_or_else(nothrow)));
+  static_assert(not noexcept(std::declval<expected<int, std::string> &>() | value_or_else(throwing)));
+  static_assert(noexcept(std::declval<optional<int> &>() | value_or_else(nothrow)));
+  static_assert(not noexcept(std::declval<optional<std::string> &>() | value_or_else([]() noexcept {
+                  return "x";
+                })));
+  SUCCEED();
+}
+
+namespace fn {
+namespace {
+struct Value final {};
+} // namespace
+
+// clang-format off
+using thunk_int = int (*)();
+static_assert(applicable_value_or_else<thunk_int, expected<int, Error>>);
+static_assert(applicable_value_or_else<thunk_int, expected<long, Error>>);          // conversion is enough
+static_assert(not applicable_value_or_else<thunk_int, expected<Value, Error>>);     // wrong type
+static_assert(not applicable_value_or_else<int (*)(int), expected<int, Error>>);    // a thunk takes no arguments
+static_assert(not applicable_value_or_else<thunk_int, expected<void, Error>>);      // void: the thunk returns nothing
+static_assert(applicable_value_or_else<void (*)(), expected<void, Error>>);
+static_assert(applicable_value_or_else<thunk_int, optional<int>>);
+static_assert(not applicable_value_or_else<thunk_int, optional<helper_immovable> &>); // the value cannot be carried
+static_assert(applicable_value_or_else<thunk_int, just<int>>);
+static_assert(applicable_value_or_else<thunk_int, choice<int>>);
+// clang-format on
+} // namespace fn
@@ -0,0 +1,165 @@
+// Copyright (c) 2026 Bronek Kozicki
+//
+// Distributed under the ISC License. See accompanying file LICENSE.md
+// or copy at https://opensource.org/licenses/ISC
+
+#include <fn/views.hpp>
+
+#include <catch2/catch_all.hpp>
+
+#include <array>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+enum class Error { Bad, Worse };
+} // namespace
+
+TEST_CASE("views", "[views][optional][expected][choice]")
+{
+  using namespace fn;
+
+  SECTION("values of optional")
+  {
+    std::vector<optional<int>> v{1, {}, 2, {}, {}, 3};
+    auto view = v | views::values;
+    using view_t = decltype(view);
+    static_assert(std::is_same_v<view_t, values_view<std::ranges::ref_view<std::vector<optional<int>>>>>);
+    static_assert(std::ranges::bidirectional_range<view_t> && std::ranges::common_range<view_t>);
+    static_assert(std::ranges::view<view_t>);
+    static_assert(std::is_same_v<std::ranges::range_reference_t<view_t>, int &>);
+
+    REQUIRE(std::ranges::equal(view, std::array{1, 2, 3}));
+    REQUIRE(std::ranges::equal(view | std::views::reverse, std::array{3, 2, 1}));
+    REQUIRE(std::ranges::distance(view) == 3);
+
+    // referring to the values as they are stored
+    for (int &i : view)
+      i *= 10;
+    REQUIRE(v[2].value() == 20);
+    REQUIRE(&*std::ranges::next(view.begin()) == &*v[2]);
+    REQUIRE(std::ranges::equal(views::values(std::as_const(v)), std::array{10, 20, 30}));
+
+    // and moved from, over a range of rvalues
+    std::vector<optional<std::string>> s{std::string{"a"}, {}};
+    auto moved = s | std::views::transform([](auto &e) -> auto && { return std::move(e); }) | views::values;
+    static_assert(std::is_same_v<std::ranges::range_reference_t<decltype(moved)>, std::string &&>);
+    std::string const a = *moved.begin();
+    REQUIRE(a == "a");
+  }
+
+  SECTION("values and errors of expected")
+  {
+    using operand_t = expected<int, Error>;
+    std::list<operand_t> l{1, unexpected(Error::Bad), 2, unexpected(Error::Worse)};
+    REQUIRE(std::ranges::equal(l | views::values, std::array{1, 2}));
+    REQUIRE(std::ranges::equal(l | views::errors, std::array{Error::Bad, Error::Worse}));
+    static_assert(std::ranges::bidirectional_range<decltype(l | views::errors)>);
+    static_assert(std::is_same_v<std::ranges::range_reference_t<decltype(l | views::errors)>, Error &>);
+
+    // an expected with a void value has errors only
+    std::vector<expected<void, Error>> w{{}, unexpected(Error::Worse)};
+    REQUIRE(std::ranges::equal(w | views::errors, std::array{Error::Worse}));
+
+    // nothing held at all
+    std::vector<operand_t> none{1, 2};
+    REQUIRE(std::ranges::empty(none | views::errors));
+  }
+
+  SECTION("values of choice, all of them")
+  {
+    std::vector<choice<int>> v{choice<int>{1}, choice<int>{2}};
+    auto view = v | views::values;
+    static_assert(std::is_same_v<std::ranges::range_reference_t<decltype(view)>, choice<int>::value_type &>);
+    REQUIRE(std::ranges::distance(view) == 2);
+    REQUIRE(&*view.begin() == &v[0].value());
+  }
+
+  SECTION("a single check for each carrier")
+  {
+    // the part is reached unchecked, so without an exception edge
+    std::vector<expected<int, Error>> v{1, unexpected(Error::Bad), 2};
+    auto view = v | views::values;
+    auto const first = view.begin();
+    static_assert(noexcept(*first));
+    auto const error = (v | views::errors).begin();
+    static_assert(noexcept(*error));
+    REQUIRE(*error == Error::Bad);
+
+    // each carrier is read once as the view steps over it, and once more only where it is yielded
+    int reads = 0;
+    auto counted = v | std::views::transform([&reads](auto &e) -> auto & {
+                     ++reads;
+                     return e;
+                   });
+    int sum = 0;
+    for (int i : counted | views::values)
+      sum += i;
+    REQUIRE(sum == 3);
+    REQUIRE(reads == 3 + 2);
+  }
+
+  SECTION("begin is found once")
+  {
+    std::vector<optional<int>> v{{}, {}, {}, 4};
+    int reads = 0;
+    auto view = v | std::views::transform([&reads](auto &e) -> auto & {
+                  ++reads;
+                  return e;
+                })
+                | views::values;
+    REQUIRE(*view.begin() == 4);
+    REQUIRE(reads == 4 + 1);
+    REQUIRE(*view.begin() == 4);
+    REQUIRE(reads == 4 + 2);
+
+    // but not by a copy of the view, which may refer into a base of its own
+    auto copy = view;
+    REQUIRE(*copy.begin() == 4);
+    REQUIRE(reads == 4 + 2 + 4 + 1);
+  }
+
+  SECTION("forward and input bases")
+  {
+    std::forward_list<optional<int>> f{{}, 1, 2};
+    auto view = f | views::values;
+    static_assert(std::ranges::forward_range<decltype(view)>);
+    static_assert(not std::ranges::bidirectional_range<decltype(view)>);
+    REQUIRE(std::ranges::equal(view, std::array{1, 2}));
+
+    // a base which is not common ends with a sentinel
+    std::vector<optional<int>> v{{}, 1, {}, 2, 3};
+    auto until = v | std::views::take_while([](auto const &) { return true; }) | views::values;
+    static_assert(not std::ranges::common_range<decltype(until)>);
+    REQUIRE(std::ranges::equal(until, std::array{1, 2, 3}));
+  }
+
+  SECTION("constant evaluation")
+  {
+    constexpr auto fn = [] {
+      std::array<optional<int>, 4> a{1, {}, 2, {}};
+      int sum = 0;
+      for (int i : a | views::values)
+        sum += i;
+      return sum;
+    };
+    static_assert(fn() == 3);
+  }
+
+  // The carriers must hold the part asked of them, and be stored: a reference to a temporary would
+  // dangle
+  using view_of = std::vector<optional<int>> &;
+  static_assert(std::is_invocable_v<views::values_t const &, view_of>);
+  static_assert(not std::is_invocable_v<views::errors_t const &, view_of>);
+  static_assert(not std::is_invocable_v<views::values_t const &, std::vector<expected<void, Error>> &>);
+  static_assert(not std::is_invocable_v<views::errors_t const &, std::vector<choice<int>> &>);
+  static_assert(not std::is_invocable_v<views::values_t const &, std::vector<int> &>);
+  using temporaries = decltype(std::views::iota(0, 3) | std::views::transform([](int i) { return optional<int>{i}; }));
+  static_assert(not std::is_invocable_v<views::values_t const &, temporaries>);
+}